@@ -82,6 +82,8 @@
 #include "linker/image_writer.h"
 #include "linker/multi_oat_relative_patcher.h"
 #include "linker/oat_writer.h"
+#include "mikrom/compile_policy.h"
+#include "mikrom/dex_capture.h"
 #include "mirror/class-inl.h"
 #include "mirror/class_loader.h"
 #include "mirror/object-inl.h"
@@ -1243,12 +1245,33 @@ class Dex2Oat final {
     InsertCompileOptions(argc, argv);
 
 		//add
-		if (ArtMethod::IsTuoke()) {
-				compiler_options_->SetCompilerFilter(CompilerFilter::kVerify);
-		}
+		ApplyMikRomCompilePolicy();
 		//add end
   }
 
+  //脱壳目标只做verify,函数保持解释执行才能被主动调用和dump,其它应用保持installd传入的过滤器
+  void ApplyMikRomCompilePolicy() {
+    if (IsBootImage()) {
+      return;
+    }
+    std::string package_name = mikrom::CompilePolicy::PackageOf(zip_location_);
+    if (package_name.empty() && !dex_locations_.empty()) {
+      package_name = mikrom::CompilePolicy::PackageOf(dex_locations_[0]);
+    }
+    if (package_name.empty()) {
+      package_name = mikrom::CompilePolicy::PackageOf(oat_location_);
+    }
+    if (!mikrom::CompilePolicy::IsTuoke(package_name)) {
+      return;
+    }
+    mikrom_tuoke_package_ = package_name;
+    if (CompilerFilter::IsAotCompilationEnabled(compiler_options_->GetCompilerFilter())) {
+      LOG(INFO) << "mikrom compile " << package_name << " with verify instead of "
+                << CompilerFilter::NameOfFilter(compiler_options_->GetCompilerFilter());
+      compiler_options_->SetCompilerFilter(CompilerFilter::kVerify);
+    }
+  }
+
   // Check whether the oat output files are writable, and open them for later. Also open a swap
   // file, if a name is given.
   bool OpenFile() {
@@ -1838,6 +1861,13 @@ class Dex2Oat final {
       // the results for all the dex files, not just the results for the current dex file.
       callbacks_->SetVerifierDeps(new verifier::VerifierDeps(dex_files));
     }
+    //add
+    //输入的dex可能已经被壳解密,编译前先保存一份
+    if (!mikrom_tuoke_package_.empty() && mikrom::DexCapture::Enabled()) {
+      TimingLogger::ScopedTiming t_capture("MikRom capture", timings_);
+      mikrom::DexCapture::Capture(Thread::Current(), mikrom_tuoke_package_, dex_files, thread_count_);
+    }
+    //add end
     // Invoke the compilation.
     if (compile_individually) {
       CompileDexFilesIndividually();
@@ -2771,6 +2801,8 @@ class Dex2Oat final {
   std::vector<std::string> dex_locations_;
   int zip_fd_;
   std::string zip_location_;
+  // Set by ApplyMikRomCompilePolicy() for a tuoke target, empty for other apps.
+  std::string mikrom_tuoke_package_;
   std::string boot_image_filename_;
   std::vector<const char*> runtime_args_;
   std::vector<std::string> image_filenames_;
@@ -40,6 +40,10 @@
 #include "jit/jit_code_cache.h"
 #include "jit/profiling_info.h"
 #include "jni/jni_internal.h"
+#include "mikrom/code_index.h"
+#include "mikrom/dex_capture.h"
+#include "mikrom/native_registry.h"
+#include "mikrom/package_config.h"
 #include "mirror/class-inl.h"
 #include "mirror/class_ext-inl.h"
 #include "mirror/executable.h"
@@ -97,99 +101,111 @@ extern "C" void art_quick_invoke_static_stub(ArtMethod*, uint32_t*, uint32_t, Th
 static_assert(ArtMethod::kRuntimeMethodDexMethodIndex == dex::kDexNoIndex,
               "Wrong runtime-method dex method index");
 
-typedef struct{
-    char packageName[128];
-    char appName[128];
-    char traceMethod[1024];
-    char debugMethod[1024];
-    bool isTuoke;
-    bool isDeep;
-    bool isInvokePrint;
-    bool isRegisterNativePrint;
-    bool isJNIMethodPrint;
-    int  pid;
-    bool init;
-}PackageItem;
-
-static PackageItem packageConfig;
-
 static std::map<void*,size_t> dex_map;
 
 
 const char* ArtMethod::GetTraceMethod(){
-    return packageConfig.traceMethod;
+    return mikrom::PackageConfig::Current().trace_method.c_str();
+}
+
+int ArtMethod::GetTraceMode(){
+    return mikrom::PackageConfig::Current().trace_mode;
+}
+
+int ArtMethod::GetTraceSampleRate(){
+    return mikrom::PackageConfig::Current().trace_sample_rate;
+}
+
+int ArtMethod::GetJniTraceMode(){
+    return mikrom::PackageConfig::Current().jni_trace_mode;
+}
+
+const char* ArtMethod::GetJniTraceLibs(){
+    return mikrom::PackageConfig::Current().jni_trace_libs.c_str();
+}
+
+const char* ArtMethod::GetJniTraceMethods(){
+    return mikrom::PackageConfig::Current().jni_trace_methods.c_str();
+}
 
+int ArtMethod::GetJniDataMaxBytes(){
+    return mikrom::PackageConfig::Current().jni_data_max_bytes;
+}
+
+int ArtMethod::GetJniDataSampleRate(){
+    return mikrom::PackageConfig::Current().jni_data_sample_rate;
 }
 
 const char* ArtMethod::GetDebugMethod(){
+    return mikrom::PackageConfig::Current().debug_method.c_str();
+}
 
-    return packageConfig.debugMethod;
+int ArtMethod::GetDebugWaitTimeout(){
+    return mikrom::PackageConfig::Current().debug_wait_timeout;
 }
 
 bool ArtMethod::IsTuoke(){
-    return packageConfig.isTuoke;
+    return mikrom::PackageConfig::Current().is_tuoke;
 }
 
 bool ArtMethod::IsDeep(){
-    return packageConfig.isDeep;
+    return mikrom::PackageConfig::Current().is_deep;
 }
 
 bool ArtMethod::IsRegisterNativePrint(){
-    return packageConfig.isRegisterNativePrint;
+    return mikrom::PackageConfig::Current().is_register_native_print;
 }
 
 bool ArtMethod::IsJNIMethodPrint(){
-    return packageConfig.isJNIMethodPrint;
+    return mikrom::PackageConfig::Current().is_jni_method_print;
 }
 
 bool ArtMethod::IsInvokePrint(){
-    return packageConfig.isInvokePrint;
+    return mikrom::PackageConfig::Current().is_invoke_print;
 }
 
-char* ArtMethod::GetPackageName(){
-    return packageConfig.packageName;
+const char* ArtMethod::GetPackageName(){
+    return mikrom::PackageConfig::Current().package_name.c_str();
 }
 
+//字符串配置可能为null,按空串处理,长度不受限制
+static std::string GetStringField(JNIEnv* env, jobject config, jclass clazz, const char* name){
+    jstring jstr = (jstring)env->GetObjectField(config, env->GetFieldID(clazz, name, "Ljava/lang/String;"));
+    if(jstr == nullptr){
+        return "";
+    }
+    const char* str = env->GetStringUTFChars(jstr, 0);
+    std::string result(str);
+    env->ReleaseStringUTFChars(jstr, str);
+    env->DeleteLocalRef(jstr);
+    return result;
+}
 
+//从Java的PackageItem生成一份新配置,整体替换当前配置,读取方无需加锁
 void ArtMethod::SetPackageItem(JNIEnv* env,jobject config){
     LOG(ERROR)<< "mikrom ArtMethod SetPackageItem enter";
     //获取Java中的实例类ParamInfo
     jclass jcInfo = env->FindClass("cn/mik/PackageItem");
-    //获取类中每一个变量的定义
-    //boolean boolValue
-    jfieldID jPackageName = env->GetFieldID(jcInfo, "packageName", "Ljava/lang/String;");
-    jfieldID jAppName = env->GetFieldID(jcInfo, "appName", "Ljava/lang/String;");
-    jfieldID jTraceMethod = env->GetFieldID(jcInfo, "traceMethod", "Ljava/lang/String;");
-    jfieldID jSleepNativeMethod = env->GetFieldID(jcInfo, "sleepNativeMethod", "Ljava/lang/String;");
-    jfieldID jIsTuoke = env->GetFieldID(jcInfo, "isTuoke", "Z");
-    jfieldID jIsDeep = env->GetFieldID(jcInfo, "isDeep", "Z");
-
-    jstring jstrPackageName = (jstring)env->GetObjectField(config, jPackageName);
-    const char* pPackageName = (char*)env->GetStringUTFChars(jstrPackageName, 0);
-    strcpy(packageConfig.packageName, pPackageName);
-
-    jstring jstrAppName = (jstring)env->GetObjectField(config, jAppName);
-    const char* pAppName = (char*)env->GetStringUTFChars(jstrAppName, 0);
-    strcpy(packageConfig.appName, pAppName);
-
-    jstring jstrTraceMethod = (jstring)env->GetObjectField(config, jTraceMethod);
-    const char* pTraceMethod = (char*)env->GetStringUTFChars(jstrTraceMethod, 0);
-    strcpy(packageConfig.traceMethod, pTraceMethod);
-
-    jstring jstrSleepNativeMethod = (jstring)env->GetObjectField(config, jSleepNativeMethod);
-    const char* pSleepNativeMethod = (char*)env->GetStringUTFChars(jstrSleepNativeMethod, 0);
-    strcpy(packageConfig.debugMethod, pSleepNativeMethod);
-
-    packageConfig.isTuoke = env->GetBooleanField(config, jIsTuoke);
-    packageConfig.isDeep = env->GetBooleanField(config, jIsDeep);
-    packageConfig.init=true;
-    packageConfig.isRegisterNativePrint=env->GetBooleanField(config, env->GetFieldID(jcInfo, "isRegisterNativePrint", "Z"));
-    packageConfig.isInvokePrint=env->GetBooleanField(config, env->GetFieldID(jcInfo, "isInvokePrint", "Z"));
-    packageConfig.isJNIMethodPrint=env->GetBooleanField(config, env->GetFieldID(jcInfo, "isJNIMethodPrint", "Z"));
-		std::ostringstream oss;
-    oss << "mikrom SetPackageItem isDeep:"<<packageConfig.isDeep<<" debugMethod:"<<packageConfig.debugMethod<<
-    " traceMethod:"<<packageConfig.traceMethod <<" isJNIMethodPrint:"<<packageConfig.isJNIMethodPrint<<" isRegisterNativePrint:"<<packageConfig.isRegisterNativePrint ;
-    LOG(ERROR)<< oss.str();
+    mikrom::PackageConfig* item = new mikrom::PackageConfig();
+    item->package_name = GetStringField(env, config, jcInfo, "packageName");
+    item->app_name = GetStringField(env, config, jcInfo, "appName");
+    item->trace_method = GetStringField(env, config, jcInfo, "traceMethod");
+    item->debug_method = GetStringField(env, config, jcInfo, "sleepNativeMethod");
+    item->debug_wait_timeout = env->GetIntField(config, env->GetFieldID(jcInfo, "debugWaitTimeout", "I"));
+    item->is_tuoke = env->GetBooleanField(config, env->GetFieldID(jcInfo, "isTuoke", "Z"));
+    item->is_deep = env->GetBooleanField(config, env->GetFieldID(jcInfo, "isDeep", "Z"));
+    item->is_register_native_print = env->GetBooleanField(config, env->GetFieldID(jcInfo, "isRegisterNativePrint", "Z"));
+    item->is_invoke_print = env->GetBooleanField(config, env->GetFieldID(jcInfo, "isInvokePrint", "Z"));
+    item->is_jni_method_print = env->GetBooleanField(config, env->GetFieldID(jcInfo, "isJNIMethodPrint", "Z"));
+    item->trace_mode = env->GetIntField(config, env->GetFieldID(jcInfo, "traceMode", "I"));
+    item->trace_sample_rate = env->GetIntField(config, env->GetFieldID(jcInfo, "traceSampleRate", "I"));
+    item->jni_trace_mode = env->GetIntField(config, env->GetFieldID(jcInfo, "jniTraceMode", "I"));
+    item->jni_trace_libs = GetStringField(env, config, jcInfo, "jniTraceLibs");
+    item->jni_trace_methods = GetStringField(env, config, jcInfo, "jniTraceMethods");
+    item->jni_data_max_bytes = env->GetIntField(config, env->GetFieldID(jcInfo, "jniDataMaxBytes", "I"));
+    item->jni_data_sample_rate = env->GetIntField(config, env->GetFieldID(jcInfo, "jniDataSampleRate", "I"));
+    env->DeleteLocalRef(jcInfo);
+    mikrom::PackageConfig::Publish(item);
 }
 
 ArtMethod* ArtMethod::GetCanonicalMethod(PointerSize pointer_size) {
@@ -272,7 +288,7 @@ extern "C" void dumpDexOver()  REQUIRES_SHARED(Locks::mutator_lock_) {
     char *dexfilepath=(char*)malloc(sizeof(char)*1000);
     LOG(ERROR) << "mikrom ArtMethod::dumpDexOver";
     int result=0;
-    char* packageName=ArtMethod::GetPackageName();
+    const char* packageName=ArtMethod::GetPackageName();
     std::map<void*, size_t>::iterator iter;
     for(iter = dex_map.begin(); iter != dex_map.end(); iter++) {
         void* begin_=iter->first;
@@ -324,7 +340,7 @@ extern "C" void dumpdexfilebyExecute(ArtMethod* artmethod)  REQUIRES_SHARED(Lock
         return;
     }
     int result=0;
-    char* packageName=ArtMethod::GetPackageName();
+    const char* packageName=ArtMethod::GetPackageName();
     const DexFile* dex_file = artmethod->GetDexFile();
     if(dex_file==nullptr){
         LOG(ERROR)<< "mikrom ArtMethod::dumpdexfilebyExecute dex_file is null";
@@ -403,7 +419,7 @@ extern "C" void dumpArtMethod(ArtMethod* artmethod)  REQUIRES_SHARED(Locks::muta
 				return;
 			}
 			int result=0;
-			char* packageName=ArtMethod::GetPackageName();
+			const char* packageName=ArtMethod::GetPackageName();
 				const DexFile* dex_file = artmethod->GetDexFile();
 				const uint8_t* begin_=dex_file->Begin();  // Start of data.
 				size_t size_=dex_file->Size();  // Length of data.
@@ -484,6 +500,11 @@ extern "C" void dumpArtMethod(ArtMethod* artmethod)  REQUIRES_SHARED(Locks::muta
 							memset(dexfilepath,0,1000);
 							int size_int=(int)dex_file->Size();
 							uint32_t method_idx=artmethod->GetDexMethodIndex();
+							//与dex2oat生成的code item索引一致的函数没有被壳修改过,不用写入ins
+							if(mikrom::CodeIndex::Unchanged(mikrom::DexCapture::Dir(packageName),*dex_,method_idx,item)){
+									free(dexfilepath);
+									return;
+							}
 							sprintf(dexfilepath,"/sdcard/Android/data/%s/files/dump/%d%s_ins_%d.bin",packageName,size_int,deepstr,(int)gettidv1());
 							int fp2=open(dexfilepath,O_CREAT|O_APPEND|O_RDWR,0666);
 							if(fp2>0){
@@ -897,16 +918,17 @@ const void* ArtMethod::RegisterNative(const void* native_method) {
                                                                   native_method,
                                                                   /*out*/&new_native_method);
   if(ArtMethod::IsRegisterNativePrint()){
-        std::ostringstream oss;
-        oss << "mikrom RomPrint RegisterNative name:"<<this->PrettyMethod().c_str()<<" native_ptr:"<<native_method<<" method_idx:"<<this->method_index_;
-    		LOG(ERROR)<<oss.str();
-    }
+    mikrom::NativeRegistry::Register(this, native_method);
+  }
   SetEntryPointFromJni(new_native_method);
   return new_native_method;
 }
 
 void ArtMethod::UnregisterNative() {
   CHECK(IsNative()) << PrettyMethod();
+  if(ArtMethod::IsRegisterNativePrint()){
+    mikrom::NativeRegistry::Unregister(this);
+  }
   // restore stub to lookup native pointer via dlsym
   SetEntryPointFromJni(GetJniDlsymLookupStub());
 }
@@ -87,10 +87,18 @@ class ArtMethod final {
   static bool IsJNIMethodPrint() REQUIRES_SHARED(Locks::mutator_lock_);
   static bool IsRegisterNativePrint() REQUIRES_SHARED(Locks::mutator_lock_);
   static const char* GetTraceMethod() REQUIRES_SHARED(Locks::mutator_lock_);
+  static int GetTraceMode() REQUIRES_SHARED(Locks::mutator_lock_);
+  static int GetTraceSampleRate() REQUIRES_SHARED(Locks::mutator_lock_);
+  static int GetJniTraceMode() REQUIRES_SHARED(Locks::mutator_lock_);
+  static const char* GetJniTraceLibs() REQUIRES_SHARED(Locks::mutator_lock_);
+  static const char* GetJniTraceMethods() REQUIRES_SHARED(Locks::mutator_lock_);
+  static int GetJniDataMaxBytes() REQUIRES_SHARED(Locks::mutator_lock_);
+  static int GetJniDataSampleRate() REQUIRES_SHARED(Locks::mutator_lock_);
   static const char* GetDebugMethod() REQUIRES_SHARED(Locks::mutator_lock_);
+  static int GetDebugWaitTimeout() REQUIRES_SHARED(Locks::mutator_lock_);
   static bool IsTuoke() ;
   static bool IsDeep() REQUIRES_SHARED(Locks::mutator_lock_);
-  static char* GetPackageName() REQUIRES_SHARED(Locks::mutator_lock_);
+  static const char* GetPackageName() REQUIRES_SHARED(Locks::mutator_lock_);
   static void SetPackageItem(JNIEnv* env,jobject config);
 
   static ArtMethod* FromReflectedMethod(const ScopedObjectAccessAlreadyRunnable& soa,
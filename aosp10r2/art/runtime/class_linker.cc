@@ -3455,8 +3455,10 @@ void ClassLinker::FixupStaticTrampolines(ObjPtr<mirror::Class> klass) {
     // Check whether the method is native, in which case it's generic JNI.
     if (quick_code == nullptr && method->IsNative()) {
       quick_code = GetQuickGenericJniStub();
-    } else if (ShouldUseInterpreterEntrypoint(method, quick_code)) {
-      // Use interpreter entry point.
+    } else if (ShouldUseInterpreterEntrypoint(method, quick_code) ||
+               (klass->GetClassLoader() != nullptr && strlen(ArtMethod::GetTraceMethod()) > 0)) {
+      // Use interpreter entry point. mikrom: traceMethod only sees interpreted
+      // methods, so app classes stay on the interpreter as in LinkCode.
       quick_code = GetQuickToInterpreterBridge();
     }
     runtime->GetInstrumentation()->UpdateMethodsCode(method, quick_code);
@@ -20,6 +20,7 @@
 #include "base/casts.h"
 #include "entrypoints/entrypoint_utils-inl.h"
 #include "indirect_reference_table.h"
+#include "mikrom/debug_gate.h"
 #include "mirror/object-inl.h"
 #include "thread-inl.h"
 #include "verify_object.h"
@@ -72,15 +73,7 @@ extern uint32_t JniMethodStart(Thread* self) {
   // TODO: Introduce special entrypoint for synchronized @FastNative methods?
   //       Or ban synchronized @FastNative outright to avoid the extra check here?
   DCHECK(!native_method->IsFastNative() || native_method->IsSynchronized());
-  std::string methodname=native_method->PrettyMethod();
-  if(ArtMethod::GetDebugMethod()!=nullptr && strlen(ArtMethod::GetDebugMethod())>0){
-    LOG(ERROR)<< "mikrom JniMethodStart strstr methodname:"<<methodname<<" debugMethod:"<<ArtMethod::GetDebugMethod();
-    if(strstr(methodname.c_str(),ArtMethod::GetDebugMethod())!=nullptr){
-            LOG(ERROR)<< "mikrom JniMethodStart methodname:"<<methodname<<" wait debug sleep 60...";
-            sleep(60);
-        }
-  }
-
+  mikrom::DebugGate::Check(self, native_method);
 
   if (!native_method->IsFastNative()) {
     // When not fast JNI we transition out of runnable.
@@ -335,14 +335,8 @@ static inline JValue Execute(
   if((result_register.GetI()==111111)){
     return ExecuteSwitchImpl<false, false>(self, accessor, shadow_frame, result_register,false);
   }
-  if(ArtMethod::GetTraceMethod()!=nullptr && strlen(ArtMethod::GetTraceMethod())>0){
-
-			if(strstr(method->PrettyMethod().c_str(),ArtMethod::GetTraceMethod())){
-				std::ostringstream oss;
-				oss<< "mikrom Execute strstr:"<<method->PrettyMethod().c_str()<<"\t"<<ArtMethod::GetTraceMethod();
-				LOG(ERROR) <<oss.str();
-				return ExecuteSwitchImpl<false, false>(self, accessor, shadow_frame, result_register,false);
-			}
+  if(mikrom::SmaliTrace::MethodId(method)!=0){
+    return ExecuteSwitchImpl<false, false>(self, accessor, shadow_frame, result_register,false);
   }
 
   //add end
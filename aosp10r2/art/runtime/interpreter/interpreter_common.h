@@ -45,6 +45,7 @@
 #include "interpreter_mterp_impl.h"
 #include "interpreter_switch_impl.h"
 #include "jit/jit-inl.h"
+#include "mikrom/frame_trace.h"
 #include "mirror/call_site.h"
 #include "mirror/class-inl.h"
 #include "mirror/dex_cache.h"
@@ -67,43 +68,11 @@ void ThrowNullPointerExceptionFromInterpreter()
     REQUIRES_SHARED(Locks::mutator_lock_);
 
 
-// Set true if you want TraceExecution invocation before each bytecode execution.
-//如果需要打开trace将该值置为true，但是开启后所有app的smali指令执行都会trace，会导致系统卡顿，可以考虑做筛选trace
- constexpr bool kTraceExecutionEnabled = false;
-/*
-参数含义
-ShadowFrame: 当前执行的java函数的栈针，pc之类的信息都可以从这里获取
-Instruction: 可以输出指令的反汇编详细信息
-*/
-
-static inline void TraceExecution(const ShadowFrame& shadow_frame, const Instruction* inst,
-                                  const uint32_t dex_pc)
-    REQUIRES_SHARED(Locks::mutator_lock_) {
-    //strstr(ArtMethod::GetTraceMethod(),shadow_frame.GetMethod()->PrettyMethod().c_str())
-
-    if(shadow_frame.GetMethod()!=nullptr && ArtMethod::GetTraceMethod()!=nullptr&&strlen(ArtMethod::GetTraceMethod())>0){
-        const char* methodName=shadow_frame.GetMethod()->PrettyMethod().c_str();
-        if(strstr(methodName,ArtMethod::GetTraceMethod())) {
-        	std::ostringstream oss;
-					oss << android::base::StringPrintf("mikrom smaliTrace 0x%x: ", dex_pc)
-							<< inst->DumpString(shadow_frame.GetMethod()->GetDexFile()) << "\t//";
-					for (uint32_t i = 0; i < shadow_frame.NumberOfVRegs(); ++i) {
-						uint32_t raw_value = shadow_frame.GetVReg(i);
-						ObjPtr<mirror::Object> ref_value = shadow_frame.GetVRegReference(i);
-						oss << android::base::StringPrintf(" vreg%u=0x%08X", i, raw_value);
-						if (ref_value != nullptr) {
-							if (ref_value->GetClass()->IsStringClass() &&
-									!ref_value->AsString()->IsValueNull()) {
-								oss << "/java.lang.String \"" << ref_value->AsString()->ToModifiedUtf8() << "\"";
-							} else {
-								oss << "/" << ref_value->PrettyTypeOf();
-							}
-						}
-					}
-					LOG(ERROR)<<oss.str();
-        }
-    }
-
+// Records the executed instruction of a method matching traceMethod, either as a
+// (method id, dex_pc) trace record or as a basic block hit depending on traceMode.
+// The listing is rebuilt on the host from the binary trace, see mikrom/frame_trace.h.
+ALWAYS_INLINE static inline void TraceExecution(mikrom::FrameTrace& frame_trace, const uint32_t dex_pc) {
+  frame_trace.OnInstruction(dex_pc);
 }
 
 
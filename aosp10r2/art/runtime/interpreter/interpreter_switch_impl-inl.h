@@ -2651,13 +2651,14 @@ ATTRIBUTE_NO_SANITIZE_ADDRESS void ExecuteSwitchImplCpp(SwitchImplContext* ctx)
   ctx->result_register=JValue();
   int inst_count = -1;
   bool flag=false;
+  mikrom::FrameTrace frame_trace(shadow_frame.GetMethod());
   //add end
   bool const interpret_one_instruction = ctx->interpret_one_instruction;
   while (true) {
 
     dex_pc = inst->GetDexPc(insns);
     shadow_frame.SetDexPC(dex_pc);
-    TraceExecution(shadow_frame, inst, dex_pc);
+    TraceExecution(frame_trace, dex_pc);
     inst_data = inst->Fetch16(0);
     {
       bool exit_loop = false;
@@ -2699,6 +2700,7 @@ ATTRIBUTE_NO_SANITIZE_ADDRESS void ExecuteSwitchImplCpp(SwitchImplContext* ctx)
             }
         }
     }
+    frame_trace.BeforeInstruction(shadow_frame, inst, inst_data);
     //add end
     switch (opcode) {
 #define OPCODE_CASE(OPCODE, OPCODE_NAME, pname, f, i, a, e, v)                                    \
@@ -2717,6 +2719,7 @@ DEX_INSTRUCTION_LIST(OPCODE_CASE)
 #undef OPCODE_CASE
     }
     //add
+    frame_trace.AfterInstruction(self, shadow_frame, dex_pc);
     if(regvalue==111111){
         if(inst_count==2&&flag){
             if(opcode == Instruction::INVOKE_STATIC || opcode == Instruction::INVOKE_STATIC_RANGE){
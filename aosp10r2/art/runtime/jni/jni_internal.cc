@@ -13,7 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-// change mikrom
+
 #include "jni_internal.h"
 
 #include <cstdarg>
@@ -658,7 +658,6 @@ class JNI {
     std::string descriptor(NormalizeJniClassDescriptor(name));
     ScopedObjectAccess soa(env);
     ObjPtr<mirror::Class> c = nullptr;
-		ShowArgStr(__FUNCTION__,name,nullptr);
     if (runtime->IsStarted()) {
       StackHandleScope<1> hs(soa.Self());
       Handle<mirror::ClassLoader> class_loader(hs.NewHandle(GetClassLoader(soa)));
@@ -983,7 +982,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(name);
     CHECK_NON_NULL_ARGUMENT(sig);
     ScopedObjectAccess soa(env);
-		ShowArgStr(__FUNCTION__,name,sig);
     return FindMethodID(soa, java_class, name, sig, false);
   }
 
@@ -993,7 +991,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(name);
     CHECK_NON_NULL_ARGUMENT(sig);
     ScopedObjectAccess soa(env);
-		ShowArgStr(__FUNCTION__,name,sig);
     return FindMethodID(soa, java_class, name, sig, true);
   }
 
@@ -1004,7 +1001,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(obj);
     CHECK_NON_NULL_ARGUMENT(mid);
     ScopedObjectAccess soa(env);
-		ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap));
     return soa.AddLocalReference<jobject>(result.GetL());
   }
@@ -1013,7 +1009,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(obj);
     CHECK_NON_NULL_ARGUMENT(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args));
     return soa.AddLocalReference<jobject>(result.GetL());
   }
@@ -1022,7 +1017,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(obj);
     CHECK_NON_NULL_ARGUMENT(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     JValue result(InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args));
     return soa.AddLocalReference<jobject>(result.GetL());
   }
@@ -1034,7 +1028,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap));
     return result.GetZ();
   }
@@ -1043,7 +1036,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args).GetZ();
   }
 
@@ -1051,7 +1043,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args).GetZ();
   }
 
@@ -1062,7 +1053,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap));
     return result.GetB();
   }
@@ -1071,7 +1061,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args).GetB();
   }
 
@@ -1079,7 +1068,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args).GetB();
   }
 
@@ -1090,7 +1078,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap));
     return result.GetC();
   }
@@ -1099,7 +1086,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args).GetC();
   }
 
@@ -1107,7 +1093,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args).GetC();
   }
 
@@ -1118,7 +1103,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap));
     return result.GetD();
   }
@@ -1127,7 +1111,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args).GetD();
   }
 
@@ -1135,7 +1118,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args).GetD();
   }
 
@@ -1146,7 +1128,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap));
     return result.GetF();
   }
@@ -1155,7 +1136,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args).GetF();
   }
 
@@ -1163,7 +1143,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args).GetF();
   }
 
@@ -1174,7 +1153,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap));
     return result.GetI();
   }
@@ -1183,7 +1161,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args).GetI();
   }
 
@@ -1191,7 +1168,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args).GetI();
   }
 
@@ -1202,7 +1178,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap));
     return result.GetJ();
   }
@@ -1211,7 +1186,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args).GetJ();
   }
 
@@ -1219,7 +1193,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args).GetJ();
   }
 
@@ -1230,7 +1203,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap));
     return result.GetS();
   }
@@ -1239,7 +1211,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args).GetS();
   }
 
@@ -1247,7 +1218,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args).GetS();
   }
 
@@ -1258,7 +1228,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, ap);
   }
 
@@ -1266,7 +1235,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     InvokeVirtualOrInterfaceWithVarArgs(soa, obj, mid, args);
   }
 
@@ -1274,7 +1242,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     InvokeVirtualOrInterfaceWithJValues(soa, obj, mid, args);
   }
 
@@ -1285,7 +1252,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(obj);
     CHECK_NON_NULL_ARGUMENT(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, obj, mid, ap));
     jobject local_result = soa.AddLocalReference<jobject>(result.GetL());
     return local_result;
@@ -1296,7 +1262,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(obj);
     CHECK_NON_NULL_ARGUMENT(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     JValue result(InvokeWithVarArgs(soa, obj, mid, args));
     return soa.AddLocalReference<jobject>(result.GetL());
   }
@@ -1306,7 +1271,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(obj);
     CHECK_NON_NULL_ARGUMENT(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     JValue result(InvokeWithJValues(soa, obj, mid, args));
     return soa.AddLocalReference<jobject>(result.GetL());
   }
@@ -1319,7 +1283,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, obj, mid, ap));
     return result.GetZ();
   }
@@ -1329,7 +1292,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, obj, mid, args).GetZ();
   }
 
@@ -1338,7 +1300,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, obj, mid, args).GetZ();
   }
 
@@ -1349,7 +1310,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, obj, mid, ap));
     return result.GetB();
   }
@@ -1359,7 +1319,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, obj, mid, args).GetB();
   }
 
@@ -1368,7 +1327,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, obj, mid, args).GetB();
   }
 
@@ -1379,7 +1337,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, obj, mid, ap));
     return result.GetC();
   }
@@ -1389,7 +1346,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, obj, mid, args).GetC();
   }
 
@@ -1398,7 +1354,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, obj, mid, args).GetC();
   }
 
@@ -1409,7 +1364,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, obj, mid, ap));
     return result.GetS();
   }
@@ -1419,7 +1373,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, obj, mid, args).GetS();
   }
 
@@ -1428,7 +1381,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, obj, mid, args).GetS();
   }
 
@@ -1439,7 +1391,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, obj, mid, ap));
     return result.GetI();
   }
@@ -1449,7 +1400,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, obj, mid, args).GetI();
   }
 
@@ -1458,7 +1408,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, obj, mid, args).GetI();
   }
 
@@ -1469,7 +1418,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, obj, mid, ap));
     return result.GetJ();
   }
@@ -1479,7 +1427,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, obj, mid, args).GetJ();
   }
 
@@ -1488,7 +1435,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, obj, mid, args).GetJ();
   }
 
@@ -1499,7 +1445,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, obj, mid, ap));
     return result.GetF();
   }
@@ -1509,7 +1454,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, obj, mid, args).GetF();
   }
 
@@ -1518,7 +1462,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, obj, mid, args).GetF();
   }
 
@@ -1529,7 +1472,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, obj, mid, ap));
     return result.GetD();
   }
@@ -1539,7 +1481,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, obj, mid, args).GetD();
   }
 
@@ -1548,7 +1489,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, obj, mid, args).GetD();
   }
 
@@ -1559,7 +1499,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     InvokeWithVarArgs(soa, obj, mid, ap);
   }
 
@@ -1568,7 +1507,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     InvokeWithVarArgs(soa, obj, mid, args);
   }
 
@@ -1577,7 +1515,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(obj);
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     InvokeWithJValues(soa, obj, mid, args);
   }
 
@@ -1586,7 +1523,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(name);
     CHECK_NON_NULL_ARGUMENT(sig);
     ScopedObjectAccess soa(env);
-		ShowArgStr(__FUNCTION__,name,sig);
     return FindFieldID(soa, java_class, name, sig, false);
   }
 
@@ -1596,9 +1532,7 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT(name);
     CHECK_NON_NULL_ARGUMENT(sig);
     ScopedObjectAccess soa(env);
-    jfieldID res=FindFieldID(soa, java_class, name, sig, true);
-		ShowArgStr(__FUNCTION__,name,sig);
-    return res;
+    return FindFieldID(soa, java_class, name, sig, true);
   }
 
   static jobject GetObjectField(JNIEnv* env, jobject obj, jfieldID fid) {
@@ -1607,7 +1541,6 @@ class JNI {
     ScopedObjectAccess soa(env);
     ArtField* f = jni::DecodeArtField(fid);
     NotifyGetField(f, obj);
-	  ShowJniField(__FUNCTION__,fid);
     ObjPtr<mirror::Object> o = soa.Decode<mirror::Object>(obj);
     return soa.AddLocalReference<jobject>(f->GetObject(o));
   }
@@ -1617,7 +1550,6 @@ class JNI {
     ScopedObjectAccess soa(env);
     ArtField* f = jni::DecodeArtField(fid);
     NotifyGetField(f, nullptr);
-	  ShowJniField(__FUNCTION__,fid);
     return soa.AddLocalReference<jobject>(f->GetObject(f->GetDeclaringClass()));
   }
 
@@ -1629,7 +1561,6 @@ class JNI {
     NotifySetObjectField(f, java_object, java_value);
     ObjPtr<mirror::Object> o = soa.Decode<mirror::Object>(java_object);
     ObjPtr<mirror::Object> v = soa.Decode<mirror::Object>(java_value);
-	  ShowJniField(__FUNCTION__,fid);
     f->SetObject<false>(o, v);
   }
 
@@ -1639,7 +1570,6 @@ class JNI {
     ArtField* f = jni::DecodeArtField(fid);
     NotifySetObjectField(f, nullptr, java_value);
     ObjPtr<mirror::Object> v = soa.Decode<mirror::Object>(java_value);
-	  ShowJniField(__FUNCTION__,fid);
     f->SetObject<false>(f->GetDeclaringClass(), v);
   }
 
@@ -1650,7 +1580,6 @@ class JNI {
   ArtField* f = jni::DecodeArtField(fid); \
   NotifyGetField(f, instance); \
   ObjPtr<mirror::Object> o = soa.Decode<mirror::Object>(instance); \
-  ShowJniField(__FUNCTION__,fid); \
   return f->Get ##fn (o)
 
 #define GET_STATIC_PRIMITIVE_FIELD(fn) \
@@ -1658,7 +1587,6 @@ class JNI {
   ScopedObjectAccess soa(env); \
   ArtField* f = jni::DecodeArtField(fid); \
   NotifyGetField(f, nullptr); \
-  ShowJniField(__FUNCTION__,fid); \
   return f->Get ##fn (f->GetDeclaringClass())
 
 #define SET_PRIMITIVE_FIELD(fn, instance, value) \
@@ -1668,7 +1596,6 @@ class JNI {
   ArtField* f = jni::DecodeArtField(fid); \
   NotifySetPrimitiveField(f, instance, JValue::FromPrimitive<decltype(value)>(value)); \
   ObjPtr<mirror::Object> o = soa.Decode<mirror::Object>(instance); \
-  ShowJniField(__FUNCTION__,fid); \
   f->Set ##fn <false>(o, value)
 
 #define SET_STATIC_PRIMITIVE_FIELD(fn, value) \
@@ -1676,7 +1603,6 @@ class JNI {
   ScopedObjectAccess soa(env); \
   ArtField* f = jni::DecodeArtField(fid); \
   NotifySetPrimitiveField(f, nullptr, JValue::FromPrimitive<decltype(value)>(value)); \
-  ShowJniField(__FUNCTION__,fid); \
   f->Set ##fn <false>(f->GetDeclaringClass(), value)
 
   static jboolean GetBooleanField(JNIEnv* env, jobject obj, jfieldID fid) {
@@ -1813,7 +1739,6 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, ap));
     jobject local_result = soa.AddLocalReference<jobject>(result.GetL());
     return local_result;
@@ -1822,7 +1747,6 @@ class JNI {
   static jobject CallStaticObjectMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, args));
     return soa.AddLocalReference<jobject>(result.GetL());
   }
@@ -1830,7 +1754,6 @@ class JNI {
   static jobject CallStaticObjectMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     JValue result(InvokeWithJValues(soa, nullptr, mid, args));
     return soa.AddLocalReference<jobject>(result.GetL());
   }
@@ -1841,7 +1764,6 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, ap));
     return result.GetZ();
   }
@@ -1849,14 +1771,12 @@ class JNI {
   static jboolean CallStaticBooleanMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, nullptr, mid, args).GetZ();
   }
 
   static jboolean CallStaticBooleanMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, nullptr, mid, args).GetZ();
   }
 
@@ -1866,7 +1786,6 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, ap));
     return result.GetB();
   }
@@ -1874,14 +1793,12 @@ class JNI {
   static jbyte CallStaticByteMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, nullptr, mid, args).GetB();
   }
 
   static jbyte CallStaticByteMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, nullptr, mid, args).GetB();
   }
 
@@ -1891,7 +1808,6 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, ap));
     return result.GetC();
   }
@@ -1899,14 +1815,12 @@ class JNI {
   static jchar CallStaticCharMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, nullptr, mid, args).GetC();
   }
 
   static jchar CallStaticCharMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, nullptr, mid, args).GetC();
   }
 
@@ -1916,7 +1830,6 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, ap));
     return result.GetS();
   }
@@ -1924,14 +1837,12 @@ class JNI {
   static jshort CallStaticShortMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, nullptr, mid, args).GetS();
   }
 
   static jshort CallStaticShortMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, nullptr, mid, args).GetS();
   }
 
@@ -1941,7 +1852,6 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, ap));
     return result.GetI();
   }
@@ -1949,14 +1859,12 @@ class JNI {
   static jint CallStaticIntMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, nullptr, mid, args).GetI();
   }
 
   static jint CallStaticIntMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, nullptr, mid, args).GetI();
   }
 
@@ -1966,7 +1874,6 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, ap));
     return result.GetJ();
   }
@@ -1974,14 +1881,12 @@ class JNI {
   static jlong CallStaticLongMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, nullptr, mid, args).GetJ();
   }
 
   static jlong CallStaticLongMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, nullptr, mid, args).GetJ();
   }
 
@@ -1991,7 +1896,6 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, ap));
     return result.GetF();
   }
@@ -1999,14 +1903,12 @@ class JNI {
   static jfloat CallStaticFloatMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, nullptr, mid, args).GetF();
   }
 
   static jfloat CallStaticFloatMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, nullptr, mid, args).GetF();
   }
 
@@ -2016,7 +1918,6 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     JValue result(InvokeWithVarArgs(soa, nullptr, mid, ap));
     return result.GetD();
   }
@@ -2024,14 +1925,12 @@ class JNI {
   static jdouble CallStaticDoubleMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     return InvokeWithVarArgs(soa, nullptr, mid, args).GetD();
   }
 
   static jdouble CallStaticDoubleMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     return InvokeWithJValues(soa, nullptr, mid, args).GetD();
   }
 
@@ -2041,21 +1940,18 @@ class JNI {
     ScopedVAArgs free_args_later(&ap);
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,ap);
     InvokeWithVarArgs(soa, nullptr, mid, ap);
   }
 
   static void CallStaticVoidMethodV(JNIEnv* env, jclass, jmethodID mid, va_list args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(mid);
     ScopedObjectAccess soa(env);
-    ShowVarArgs(soa,__FUNCTION__,mid,args);
     InvokeWithVarArgs(soa, nullptr, mid, args);
   }
 
   static void CallStaticVoidMethodA(JNIEnv* env, jclass, jmethodID mid, const jvalue* args) {
     CHECK_NON_NULL_ARGUMENT_RETURN_VOID(mid);
     ScopedObjectAccess soa(env);
-    ShowJValue(soa,__FUNCTION__,mid,args);
     InvokeWithJValues(soa, nullptr, mid, args);
   }
 
@@ -2069,7 +1965,6 @@ class JNI {
       return nullptr;
     }
     ScopedObjectAccess soa(env);
-    ShowArgStr(__FUNCTION__,(const char*)chars,nullptr);
     ObjPtr<mirror::String> result = mirror::String::AllocFromUtf16(soa.Self(), char_count, chars);
     return soa.AddLocalReference<jstring>(result);
   }
@@ -2079,7 +1974,6 @@ class JNI {
       return nullptr;
     }
     ScopedObjectAccess soa(env);
-    ShowArgStr(__FUNCTION__,utf,nullptr);
     ObjPtr<mirror::String> result = mirror::String::AllocFromModifiedUtf8(soa.Self(), utf);
     return soa.AddLocalReference<jstring>(result);
   }
@@ -2088,7 +1982,6 @@ class JNI {
     CHECK_NON_NULL_ARGUMENT_RETURN_ZERO(java_string);
     ScopedObjectAccess soa(env);
     ObjPtr<mirror::String> s = soa.Decode<mirror::String>(java_string);
-    ShowArgStr(__FUNCTION__,(const char*)s->GetValue(),nullptr);
     return s->GetLength();
   }
 
@@ -2157,15 +2050,12 @@ class JNI {
       if (is_copy != nullptr) {
         *is_copy = JNI_TRUE;
       }
-		  ShowArgStr(__FUNCTION__,(const char*)chars,nullptr);
       return chars;
     }
     if (is_copy != nullptr) {
       *is_copy = JNI_FALSE;
     }
-    jchar* res=static_cast<jchar*>(s->GetValue());
-    ShowArgStr(__FUNCTION__,(const char*)res,nullptr);
-    return res;
+    return static_cast<jchar*>(s->GetValue());
   }
 
   static void ReleaseStringChars(JNIEnv* env, jstring java_string, const jchar* chars) {
@@ -2173,7 +2063,6 @@ class JNI {
     ScopedObjectAccess soa(env);
     ObjPtr<mirror::String> s = soa.Decode<mirror::String>(java_string);
     if (s->IsCompressed() || (s->IsCompressed() == false && chars != s->GetValue())) {
-			ShowArgStr(__FUNCTION__,(const char*)chars,nullptr);
       delete[] chars;
     }
   }
@@ -2232,8 +2121,6 @@ class JNI {
   }
 
   static const char* GetStringUTFChars(JNIEnv* env, jstring java_string, jboolean* is_copy) {
-
-
     if (java_string == nullptr) {
       return nullptr;
     }
@@ -2254,7 +2141,6 @@ class JNI {
       ConvertUtf16ToModifiedUtf8(bytes, byte_count, chars, s->GetLength());
     }
     bytes[byte_count] = '\0';
-	  ShowArgStr(__FUNCTION__,bytes,nullptr);
     return bytes;
   }
 
@@ -2271,7 +2157,6 @@ class JNI {
       return 0;
     }
     ObjPtr<mirror::Array> array = obj->AsArray();
-	  ShowArgStr(__FUNCTION__,nullptr,nullptr);
     return array->GetLength();
   }
 
@@ -2280,7 +2165,6 @@ class JNI {
     ScopedObjectAccess soa(env);
     ObjPtr<mirror::ObjectArray<mirror::Object>> array =
         soa.Decode<mirror::ObjectArray<mirror::Object>>(java_array);
-	  ShowArgStr(__FUNCTION__,nullptr,nullptr);
     return soa.AddLocalReference<jobject>(array->Get(index));
   }
 
@@ -2291,7 +2175,6 @@ class JNI {
     ObjPtr<mirror::ObjectArray<mirror::Object>> array =
         soa.Decode<mirror::ObjectArray<mirror::Object>>(java_array);
     ObjPtr<mirror::Object> value = soa.Decode<mirror::Object>(java_value);
-	  ShowArgStr(__FUNCTION__,nullptr,nullptr);
     array->Set<false>(index, value);
   }
 
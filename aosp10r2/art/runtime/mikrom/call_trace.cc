@@ -0,0 +1,92 @@
+// change mikrom
+#include "mikrom/call_trace.h"
+
+#include <string.h>
+
+#include <android-base/logging.h>
+
+#include "art_method-inl.h"
+#include "base/time_utils.h"
+#include "gc/scoped_gc_critical_section.h"
+#include "mikrom/smali_trace.h"
+#include "mikrom/trace_buffer.h"
+#include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-inl.h"
+#include "thread_list.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+static constexpr const char* kCallTraceInstrumentationKey = "mikrom";
+
+static CallTrace* g_call_trace = nullptr;
+
+static void WriteCallRecord(RecordType type, ArtMethod* method)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (method->IsRuntimeMethod()) {
+    return;
+  }
+  uint32_t method_id = SmaliTrace::MethodId(method->GetInterfaceMethodIfProxy(kRuntimePointerSize));
+  if (LIKELY(method_id == 0)) {
+    return;
+  }
+  CallRecord record;
+  record.header.type = type;
+  record.header.size = sizeof(record);
+  record.method_id = method_id;
+  record.time_ns = NanoTime();
+  TraceBuffer::Append(&record, sizeof(record));
+}
+
+}  // namespace
+
+void CallTrace::Start(Thread* self) {
+  {
+    ScopedObjectAccess soa(self);
+    const char* trace_method = ArtMethod::GetTraceMethod();
+    if (ArtMethod::GetTraceMode() != kTraceModeCalls ||
+        trace_method == nullptr || trace_method[0] == '\0' ||
+        g_call_trace != nullptr) {
+      return;
+    }
+  }
+  Runtime* runtime = Runtime::Current();
+  g_call_trace = new CallTrace();
+  {
+    // EnableMethodTracing visits the classes to install the entry/exit stubs.
+    gc::ScopedGCCriticalSection gcs(self,
+                                    gc::kGcCauseInstrumentation,
+                                    gc::kCollectorTypeInstrumentation);
+    ScopedSuspendAll ssa(__FUNCTION__);
+    instrumentation::Instrumentation* instrumentation = runtime->GetInstrumentation();
+    instrumentation->AddListener(g_call_trace,
+                                 instrumentation::Instrumentation::kMethodEntered |
+                                 instrumentation::Instrumentation::kMethodExited |
+                                 instrumentation::Instrumentation::kMethodUnwind);
+    instrumentation->EnableMethodTracing(kCallTraceInstrumentationKey,
+                                         /* needs_interpreter= */ false);
+  }
+  LOG(ERROR) << "mikrom callTrace started";
+}
+
+void CallTrace::MethodEntered(Thread*, Handle<mirror::Object>, ArtMethod* method, uint32_t) {
+  WriteCallRecord(kRecordMethodEnter, method);
+}
+
+void CallTrace::MethodExited(Thread*,
+                             Handle<mirror::Object>,
+                             ArtMethod* method,
+                             uint32_t,
+                             const JValue&) {
+  WriteCallRecord(kRecordMethodExit, method);
+}
+
+void CallTrace::MethodUnwind(Thread*, Handle<mirror::Object>, ArtMethod* method, uint32_t) {
+  WriteCallRecord(kRecordMethodUnwind, method);
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,61 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_CALL_TRACE_H_
+#define ART_RUNTIME_MIKROM_CALL_TRACE_H_
+
+#include <stdint.h>
+
+#include "base/locks.h"
+#include "base/macros.h"
+#include "instrumentation.h"
+
+namespace art {
+
+class Thread;
+
+namespace mikrom {
+
+// Call trace mode (traceMode 3): method entry/exit events of the methods matching
+// traceMethod, timestamped and written to the per-thread trace buffers. Built on
+// the instrumentation entry/exit listeners, so compiled code is traced too without
+// stepping through the interpreter. mikromtrace calls turns the events into
+// folded stacks for flamegraph.pl or a Chrome trace JSON.
+class CallTrace final : public instrumentation::InstrumentationListener {
+ public:
+  // Installs the listener if the current config asks for it. Called after the
+  // config is set, |self| must not hold the mutator lock.
+  static void Start(Thread* self) REQUIRES(!Locks::mutator_lock_);
+
+  void MethodEntered(Thread* thread,
+                     Handle<mirror::Object> this_object,
+                     ArtMethod* method,
+                     uint32_t dex_pc) override REQUIRES_SHARED(Locks::mutator_lock_);
+  void MethodExited(Thread* thread,
+                    Handle<mirror::Object> this_object,
+                    ArtMethod* method,
+                    uint32_t dex_pc,
+                    const JValue& return_value) override REQUIRES_SHARED(Locks::mutator_lock_);
+  void MethodUnwind(Thread* thread,
+                    Handle<mirror::Object> this_object,
+                    ArtMethod* method,
+                    uint32_t dex_pc) override REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Not listened to.
+  void DexPcMoved(Thread*, Handle<mirror::Object>, ArtMethod*, uint32_t) override {}
+  void FieldRead(Thread*, Handle<mirror::Object>, ArtMethod*, uint32_t, ArtField*) override {}
+  void FieldWritten(Thread*, Handle<mirror::Object>, ArtMethod*, uint32_t, ArtField*,
+                    const JValue&) override {}
+  void ExceptionThrown(Thread*, Handle<mirror::Throwable>) override {}
+  void ExceptionHandled(Thread*, Handle<mirror::Throwable>) override {}
+  void Branch(Thread*, ArtMethod*, uint32_t, int32_t) override {}
+  void WatchedFramePop(Thread*, const ShadowFrame&) override {}
+
+ private:
+  CallTrace() {}
+
+  DISALLOW_COPY_AND_ASSIGN(CallTrace);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_CALL_TRACE_H_
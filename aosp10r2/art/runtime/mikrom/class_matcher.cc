@@ -0,0 +1,101 @@
+// change mikrom
+#include "mikrom/class_matcher.h"
+
+#include <string.h>
+
+#include <deque>
+
+namespace art {
+namespace mikrom {
+
+ClassMatcher* ClassMatcher::Compile(const std::vector<std::string>& patterns) {
+  ClassMatcher* matcher = new ClassMatcher();
+  memset(matcher->columns_, 0, sizeof(matcher->columns_));
+  uint32_t column_count = 1;
+  for (const std::string& pattern : patterns) {
+    for (char ch : pattern) {
+      uint8_t& column = matcher->columns_[static_cast<uint8_t>(ch)];
+      if (column == 0) {
+        column = static_cast<uint8_t>(column_count++);
+      }
+    }
+  }
+  if (column_count > 255) {
+    // More distinct bytes than columns, give every byte its own.
+    for (uint32_t c = 0; c < 256; ++c) {
+      matcher->columns_[c] = static_cast<uint8_t>(c);
+    }
+    column_count = 256;
+  }
+
+  // The trie, with -1 for a missing edge.
+  std::vector<int32_t> trie(column_count, -1);
+  std::vector<bool> terminal(1, false);
+  for (const std::string& pattern : patterns) {
+    if (pattern.empty()) {
+      continue;
+    }
+    size_t state = 0;
+    for (char ch : pattern) {
+      size_t slot = state * column_count + matcher->columns_[static_cast<uint8_t>(ch)];
+      if (trie[slot] < 0) {
+        trie[slot] = static_cast<int32_t>(terminal.size());
+        terminal.push_back(false);
+        trie.resize(trie.size() + column_count, -1);
+      }
+      state = static_cast<size_t>(trie[slot]);
+    }
+    terminal[state] = true;
+  }
+  if (terminal.size() == 1) {
+    delete matcher;
+    return nullptr;
+  }
+
+  // Breadth first, missing edges take the transition of the failure state,
+  // which is complete already; a state is terminal if any suffix of it is.
+  std::vector<uint32_t>& next = matcher->next_;
+  next.assign(trie.size(), 0);
+  std::vector<uint32_t> fail(terminal.size(), 0);
+  std::deque<uint32_t> queue;
+  for (uint32_t c = 0; c < column_count; ++c) {
+    if (trie[c] >= 0) {
+      next[c] = static_cast<uint32_t>(trie[c]);
+      queue.push_back(next[c]);
+    }
+  }
+  while (!queue.empty()) {
+    uint32_t state = queue.front();
+    queue.pop_front();
+    terminal[state] = terminal[state] || terminal[fail[state]];
+    for (uint32_t c = 0; c < column_count; ++c) {
+      size_t slot = static_cast<size_t>(state) * column_count + c;
+      uint32_t fallback = next[static_cast<size_t>(fail[state]) * column_count + c];
+      if (trie[slot] >= 0) {
+        uint32_t child = static_cast<uint32_t>(trie[slot]);
+        fail[child] = fallback;
+        next[slot] = child;
+        queue.push_back(child);
+      } else {
+        next[slot] = fallback;
+      }
+    }
+  }
+  matcher->column_count_ = column_count;
+  matcher->terminal_ = std::move(terminal);
+  return matcher;
+}
+
+bool ClassMatcher::Matches(const char* name, size_t length) const {
+  size_t state = 0;
+  for (size_t i = 0; i < length; ++i) {
+    state = next_[state * column_count_ + columns_[static_cast<uint8_t>(name[i])]];
+    if (terminal_[state]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace mikrom
+}  // namespace art
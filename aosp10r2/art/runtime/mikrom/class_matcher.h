@@ -0,0 +1,52 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_CLASS_MATCHER_H_
+#define ART_RUNTIME_MIKROM_CLASS_MATCHER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace art {
+namespace mikrom {
+
+// Substring matcher for the white and break class lists of Fartext: the
+// patterns are compiled once into an Aho-Corasick automaton, turned into a
+// dense transition table over the bytes that occur in them, so a class name is
+// checked against all patterns with one table load per character instead of
+// one String.contains() per pattern.
+class ClassMatcher {
+ public:
+  // Empty patterns are ignored. Returns null if none are left.
+  static ClassMatcher* Compile(const std::vector<std::string>& patterns);
+
+  // Whether any pattern occurs in |name|.
+  bool Matches(const char* name, size_t length) const;
+
+  size_t StateCount() const { return terminal_.size(); }
+
+ private:
+  ClassMatcher() {}
+
+  // Byte -> column in |next_|; bytes in no pattern share column 0.
+  uint8_t columns_[256];
+  uint32_t column_count_ = 0;
+  // Row-major |states x column_count_| transition table.
+  std::vector<uint32_t> next_;
+  std::vector<bool> terminal_;
+};
+// The names a ClassMatcher pair lets through: those matching |white| (if not
+// null) and not matching |black| (if not null).
+inline bool ClassAllowed(const ClassMatcher* white,
+                         const ClassMatcher* black,
+                         const char* name,
+                         size_t length) {
+  return (white == nullptr || white->Matches(name, length)) &&
+         (black == nullptr || !black->Matches(name, length));
+}
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_CLASS_MATCHER_H_
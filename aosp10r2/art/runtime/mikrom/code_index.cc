@@ -0,0 +1,142 @@
+// change mikrom
+#include "mikrom/code_index.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <android-base/logging.h>
+
+#include "dex/class_accessor-inl.h"
+#include "dex/dex_file-inl.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+// Loaded indexes by dex file, null when the dex has none. Dex files of a
+// running app are not unloaded while it is dumped, so the keys stay valid.
+static std::mutex g_lock;
+static std::map<const DexFile*, std::unique_ptr<std::vector<CodeIndexEntry>>> g_indexes;
+
+static std::unique_ptr<std::vector<CodeIndexEntry>> Load(const std::string& dir,
+                                                         const DexFile& dex_file) {
+  uint32_t checksum = dex_file.GetHeader().checksum_;
+  char path[PATH_MAX];
+  snprintf(path, sizeof(path), "%s/%08x_codeindex.bin", dir.c_str(), checksum);
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullptr;
+  }
+  std::unique_ptr<std::vector<CodeIndexEntry>> entries;
+  CodeIndexHeader header;
+  struct stat st;
+  // The count is only trusted when the file holds exactly that many entries,
+  // so a truncated or forged file cannot size the allocation.
+  if (fstat(fd, &st) == 0 &&
+      TEMP_FAILURE_RETRY(read(fd, &header, sizeof(header))) == sizeof(header) &&
+      header.magic == CodeIndexHeader::kMagic &&
+      header.version == CodeIndexHeader::kVersion &&
+      header.dex_checksum == checksum &&
+      static_cast<uint64_t>(st.st_size) ==
+          sizeof(header) + static_cast<uint64_t>(header.count) * sizeof(CodeIndexEntry)) {
+    entries.reset(new std::vector<CodeIndexEntry>(header.count));
+    size_t bytes = header.count * sizeof(CodeIndexEntry);
+    if (TEMP_FAILURE_RETRY(read(fd, entries->data(), bytes)) != static_cast<ssize_t>(bytes)) {
+      entries.reset();
+    }
+  }
+  close(fd);
+  LOG(ERROR) << "mikrom CodeIndex " << path << (entries != nullptr ? " loaded" : " is invalid");
+  return entries;
+}
+
+}  // namespace
+
+uint32_t CodeIndex::Hash(const uint8_t* data, size_t size) {
+  uint32_t h = 0x811c9dc5u;
+  for (size_t i = 0; i < size; ++i) {
+    h ^= data[i];
+    h *= 0x01000193u;
+  }
+  return h;
+}
+
+std::vector<uint8_t> CodeIndex::Build(const DexFile& dex_file) {
+  std::vector<CodeIndexEntry> entries;
+  for (ClassAccessor accessor : dex_file.GetClasses()) {
+    for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+      uint32_t offset = method.GetCodeItemOffset();
+      if (offset == 0) {
+        continue;
+      }
+      const dex::CodeItem* code_item = dex_file.GetCodeItem(offset);
+      CodeIndexEntry entry;
+      entry.method_idx = method.GetIndex();
+      entry.offset = offset;
+      entry.size = dex_file.GetCodeItemSize(*code_item);
+      entry.hash = Hash(reinterpret_cast<const uint8_t*>(code_item), entry.size);
+      entries.push_back(entry);
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const CodeIndexEntry& a, const CodeIndexEntry& b) {
+              return a.method_idx < b.method_idx;
+            });
+  CodeIndexHeader header;
+  header.magic = CodeIndexHeader::kMagic;
+  header.version = CodeIndexHeader::kVersion;
+  header.dex_checksum = dex_file.GetHeader().checksum_;
+  header.count = static_cast<uint32_t>(entries.size());
+  std::vector<uint8_t> out(sizeof(header) + entries.size() * sizeof(CodeIndexEntry));
+  memcpy(out.data(), &header, sizeof(header));
+  if (!entries.empty()) {
+    memcpy(out.data() + sizeof(header), entries.data(), entries.size() * sizeof(CodeIndexEntry));
+  }
+  return out;
+}
+
+bool CodeIndex::Unchanged(const std::string& dir,
+                          const DexFile& dex_file,
+                          uint32_t method_idx,
+                          const uint8_t* code_item) {
+  const std::vector<CodeIndexEntry>* entries;
+  {
+    std::lock_guard<std::mutex> lock(g_lock);
+    auto it = g_indexes.find(&dex_file);
+    if (it == g_indexes.end()) {
+      it = g_indexes.emplace(&dex_file, Load(dir, dex_file)).first;
+    }
+    entries = it->second.get();
+  }
+  // Code item offsets are relative to the data section, which only differs
+  // from Begin() for a CompactDex.
+  if (entries == nullptr || code_item < dex_file.DataBegin()) {
+    return false;
+  }
+  auto it = std::lower_bound(entries->begin(), entries->end(), method_idx,
+                             [](const CodeIndexEntry& entry, uint32_t idx) {
+                               return entry.method_idx < idx;
+                             });
+  if (it == entries->end() || it->method_idx != method_idx) {
+    return false;
+  }
+  // A shell that moves the code item or restores other bytes is dumped.
+  size_t offset = code_item - dex_file.DataBegin();
+  if (offset != it->offset || offset + it->size > dex_file.DataSize()) {
+    return false;
+  }
+  return Hash(code_item, it->size) == it->hash;
+}
+
+}  // namespace mikrom
+}  // namespace art
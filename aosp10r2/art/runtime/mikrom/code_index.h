@@ -0,0 +1,60 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_CODE_INDEX_H_
+#define ART_RUNTIME_MIKROM_CODE_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace art {
+
+class DexFile;
+
+namespace mikrom {
+
+// Code item index written by dex2oat next to the captured dex
+// (<checksum>_codeindex.bin, see DexCapture) and used by dumpArtMethod to skip
+// methods whose code item in memory is still the one that was on disk. Only
+// methods a shell restores or rewrites at runtime end up in the ins dump.
+struct CodeIndexHeader {
+  static constexpr uint32_t kMagic = 0x584b494d;  // "MIKX"
+  static constexpr uint32_t kVersion = 1;
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t dex_checksum;  // DexFile::Header::checksum_
+  uint32_t count;         // CodeIndexEntry records following, sorted by method_idx.
+};
+
+struct CodeIndexEntry {
+  uint32_t method_idx;
+  uint32_t offset;  // Of the code item, from DataBegin() as in the class data.
+  uint32_t size;    // Code item bytes, up to the end of the catch handlers.
+  uint32_t hash;    // FNV-1a of those bytes.
+};
+
+static_assert(sizeof(CodeIndexHeader) == 16, "CodeIndexHeader layout");
+static_assert(sizeof(CodeIndexEntry) == 16, "CodeIndexEntry layout");
+
+class CodeIndex {
+ public:
+  static uint32_t Hash(const uint8_t* data, size_t size);
+
+  // Index of every method with code in |dex_file|, header included.
+  static std::vector<uint8_t> Build(const DexFile& dex_file);
+
+  // Whether the code item of |method_idx| at |code_item| matches the index of
+  // |dex_file| found under |dir|. False when there is no index for the dex, so
+  // unknown dex files are dumped in full.
+  static bool Unchanged(const std::string& dir,
+                        const DexFile& dex_file,
+                        uint32_t method_idx,
+                        const uint8_t* code_item);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_CODE_INDEX_H_
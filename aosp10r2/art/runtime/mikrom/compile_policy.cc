@@ -0,0 +1,110 @@
+// change mikrom
+#include "mikrom/compile_policy.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <android-base/properties.h>
+#include <android-base/strings.h>
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+// Must match cn.mik.TargetFilter.
+static constexpr int32_t kBits = 352;
+static constexpr int32_t kHashes = 3;
+
+// String.hashCode() of an ASCII name.
+static int32_t JavaHash(const std::string& name) {
+  uint32_t h = 0;
+  for (unsigned char c : name) {
+    h = h * 31u + c;
+  }
+  return static_cast<int32_t>(h);
+}
+
+static int32_t Fnv1a(const std::string& name) {
+  uint32_t h = 0x811c9dc5u;
+  for (unsigned char c : name) {
+    h ^= c;
+    h *= 0x01000193u;
+  }
+  return static_cast<int32_t>(h | 1u);
+}
+
+static int32_t Bit(int32_t hash1, int32_t hash2, int32_t i) {
+  int32_t sum = static_cast<int32_t>(static_cast<uint32_t>(hash1) +
+                                     static_cast<uint32_t>(i) * static_cast<uint32_t>(hash2));
+  int32_t bit = sum % kBits;
+  return bit < 0 ? bit + kBits : bit;
+}
+
+static int HexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+}  // namespace
+
+std::string CompilePolicy::PackageOf(const std::string& location) {
+  std::vector<std::string> parts = android::base::Split(location, "/");
+  // Split() keeps the empty component before the leading '/'.
+  if (parts.size() < 2 || !parts[0].empty()) {
+    return "";
+  }
+  parts.erase(parts.begin());
+  std::string package;
+  if (parts.size() > 3 && parts[0] == "data" && parts[1] == "app") {
+    package = parts[2];
+  } else if (parts.size() > 5 && parts[0] == "mnt" && parts[1] == "expand" && parts[3] == "app") {
+    package = parts[4];
+  } else if (parts.size() > 3 && parts[0] == "data" && parts[1] == "data") {
+    return parts[2];
+  } else if (parts.size() > 4 && parts[0] == "data" &&
+             (parts[1] == "user" || parts[1] == "user_de")) {
+    return parts[3];
+  } else {
+    return "";
+  }
+  // Code paths are <package>-<random suffix>; package names never contain '-'.
+  size_t dash = package.find('-');
+  return dash == std::string::npos ? package : package.substr(0, dash);
+}
+
+bool CompilePolicy::IsTuoke(const std::string& package_name) {
+  if (package_name.empty()) {
+    return false;
+  }
+  std::string value = android::base::GetProperty(kTuokeProperty, "");
+  if (value.size() != static_cast<size_t>(kBits / 4)) {
+    return false;
+  }
+  int32_t hash1 = JavaHash(package_name);
+  int32_t hash2 = Fnv1a(package_name);
+  for (int32_t k = 0; k < kHashes; ++k) {
+    int32_t b = Bit(hash1, hash2, k);
+    // Each byte is printed as two hex digits, high nibble first.
+    int nibble = HexDigit(value[(b / 8) * 2 + (b % 8 < 4 ? 1 : 0)]);
+    if (nibble < 0) {
+      return false;
+    }
+    if ((nibble & (1 << (b % 4))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,33 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_COMPILE_POLICY_H_
+#define ART_RUNTIME_MIKROM_COMPILE_POLICY_H_
+
+#include <string>
+
+namespace art {
+namespace mikrom {
+
+// Decides in dex2oat whether an app is a tuoke target and should only be
+// verified. The package config of the app process is not available there, so
+// MikRomService publishes the packages with isTuoke set as a bloom filter in
+// sys.mikrom.tuoke, encoded like cn.mik.TargetFilter. Every dexopt, install and
+// background job alike, goes through dex2oat, so all of them follow the policy.
+// A false positive only costs one app its AOT code.
+class CompilePolicy {
+ public:
+  static constexpr const char* kTuokeProperty = "sys.mikrom.tuoke";
+
+  // The package owning an app dex, apk or oat location under /data/app,
+  // /mnt/expand/<uuid>/app, /data/data or /data/user(_de)/<user>, or an empty
+  // string for anything else.
+  static std::string PackageOf(const std::string& location);
+
+  // Whether |package_name| may be a tuoke target. False when the property is
+  // missing or malformed, so other apps keep their compiler filter.
+  static bool IsTuoke(const std::string& package_name);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_COMPILE_POLICY_H_
@@ -0,0 +1,199 @@
+// change mikrom
+#include "mikrom/coverage.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <android-base/logging.h>
+
+#include "art_method-inl.h"
+#include "base/leb128.h"
+#include "dex/code_item_accessors-inl.h"
+#include "dex/dex_file_exception_helpers.h"
+#include "dex/dex_instruction-inl.h"
+#include "mikrom/method_table.h"
+#include "mikrom/trace_buffer.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+static constexpr size_t kMaxRecordSize = (1u << 24) - 1;
+static constexpr int kSnapshotIntervalMs = 1000;
+
+static IdTable<MethodCoverage> g_methods;
+static std::once_flag g_writer_once;
+
+static void ReadInt32Targets(const uint16_t* insns,
+                             uint32_t insns_size,
+                             uint32_t switch_pc,
+                             uint32_t first,
+                             uint32_t count,
+                             std::vector<bool>* leaders) {
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t pos = first + i * 2;
+    if (pos + 1 >= insns_size) {
+      return;
+    }
+    int32_t offset = static_cast<int32_t>(insns[pos] | (static_cast<uint32_t>(insns[pos + 1]) << 16));
+    uint32_t target = switch_pc + offset;
+    if (target < insns_size) {
+      (*leaders)[target] = true;
+    }
+  }
+}
+
+static void MarkSwitchTargets(const uint16_t* insns,
+                              uint32_t insns_size,
+                              uint32_t switch_pc,
+                              const Instruction& inst,
+                              std::vector<bool>* leaders) {
+  uint32_t payload = switch_pc + inst.VRegB_31t();
+  if (payload + 2 > insns_size) {
+    return;
+  }
+  uint32_t count = insns[payload + 1];
+  if (insns[payload] == Instruction::kPackedSwitchSignature) {
+    // ident, size, first_key (int32), targets[size]
+    ReadInt32Targets(insns, insns_size, switch_pc, payload + 4, count, leaders);
+  } else if (insns[payload] == Instruction::kSparseSwitchSignature) {
+    // ident, size, keys[size], targets[size]
+    ReadInt32Targets(insns, insns_size, switch_pc, payload + 2 + count * 2, count, leaders);
+  }
+}
+
+// A block starts at pc 0, at every branch, switch and catch target, and after
+// every instruction that does not simply fall through.
+static std::vector<bool> FindLeaders(ArtMethod* method, uint32_t insns_size)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  std::vector<bool> leaders(insns_size, false);
+  CodeItemDataAccessor accessor = method->DexInstructionData();
+  const uint16_t* insns = accessor.Insns();
+  leaders[0] = true;
+  for (const DexInstructionPcPair& pair : accessor) {
+    const Instruction& inst = pair.Inst();
+    uint32_t pc = pair.DexPc();
+    uint32_t next = pc + inst.SizeInCodeUnits();
+    if (next > insns_size) {
+      break;
+    }
+    if (inst.IsBranch()) {
+      uint32_t target = pc + inst.GetTargetOffset();
+      if (target < insns_size) {
+        leaders[target] = true;
+      }
+    } else if (inst.IsSwitch()) {
+      MarkSwitchTargets(insns, insns_size, pc, inst, &leaders);
+    }
+    bool ends_block = inst.IsBranch() || inst.IsSwitch() || inst.IsReturn() ||
+        inst.Opcode() == Instruction::THROW;
+    if (ends_block && next < insns_size) {
+      leaders[next] = true;
+    }
+  }
+  if (accessor.TriesSize() != 0) {
+    const uint8_t* handlers = accessor.GetCatchHandlerData();
+    uint32_t handlers_size = DecodeUnsignedLeb128(&handlers);
+    for (uint32_t i = 0; i < handlers_size; ++i) {
+      CatchHandlerIterator it(handlers);
+      for (; it.HasNext(); it.Next()) {
+        if (it.GetHandlerAddress() < insns_size) {
+          leaders[it.GetHandlerAddress()] = true;
+        }
+      }
+      handlers = it.EndDataPointer();
+    }
+  }
+  return leaders;
+}
+
+static void WriteBlocksRecord(uint32_t method_id, const std::vector<uint32_t>& block_start) {
+  uint32_t block_count = static_cast<uint32_t>(block_start.size());
+  BlocksRecord record;
+  record.header.type = kRecordBlocks;
+  record.header.size = sizeof(record) + block_count * sizeof(uint32_t);
+  record.method_id = method_id;
+  record.block_count = block_count;
+  TraceBuffer::Append(&record, sizeof(record), block_start.data(), block_count * sizeof(uint32_t));
+}
+
+static void WriteSnapshot(uint32_t id, MethodCoverage* coverage) {
+  if (!coverage->TakeDirty()) {
+    return;
+  }
+  uint32_t words = (coverage->BlockCount() + 31) / 32;
+  std::vector<uint32_t> bits(words);
+  for (uint32_t i = 0; i < words; ++i) {
+    bits[i] = coverage->BitsWord(i);
+  }
+  CoverageRecord record;
+  record.header.type = kRecordCoverage;
+  record.header.size = sizeof(record) + words * sizeof(uint32_t);
+  record.method_id = id;
+  record.block_count = coverage->BlockCount();
+  TraceBuffer::Append(&record, sizeof(record), bits.data(), words * sizeof(uint32_t));
+}
+
+static void WriterLoop() {
+  while (true) {
+    usleep(kSnapshotIntervalMs * 1000);
+    g_methods.VisitAll(WriteSnapshot);
+  }
+}
+
+}  // namespace
+
+void Coverage::Register(ArtMethod* method, uint32_t method_id) {
+  CodeItemInstructionAccessor accessor = method->DexInstructions();
+  if (!accessor.HasCodeItem() || accessor.InsnsSizeInCodeUnits() == 0) {
+    return;
+  }
+  uint32_t insns_size = accessor.InsnsSizeInCodeUnits();
+  std::vector<bool> leaders = FindLeaders(method, insns_size);
+
+  std::unique_ptr<MethodCoverage> coverage(new MethodCoverage());
+  coverage->insns_size_ = insns_size;
+  coverage->block_of_.reset(new int32_t[insns_size]);
+  std::vector<uint32_t> block_start;
+  for (uint32_t pc = 0; pc < insns_size; ++pc) {
+    if (leaders[pc]) {
+      coverage->block_of_[pc] = static_cast<int32_t>(block_start.size());
+      block_start.push_back(pc);
+    } else {
+      coverage->block_of_[pc] = -1;
+    }
+  }
+  uint32_t block_count = static_cast<uint32_t>(block_start.size());
+  if (sizeof(BlocksRecord) + block_count * sizeof(uint32_t) > kMaxRecordSize) {
+    LOG(ERROR) << "mikrom coverage " << method->PrettyMethod() << " has too many blocks";
+    return;
+  }
+  coverage->block_count_ = block_count;
+  uint32_t words = (block_count + 31) / 32;
+  coverage->bits_.reset(new std::atomic<uint32_t>[words]);
+  for (uint32_t i = 0; i < words; ++i) {
+    coverage->bits_[i].store(0, std::memory_order_relaxed);
+  }
+
+  // Written before the method becomes visible, so that no snapshot precedes it.
+  WriteBlocksRecord(method_id, block_start);
+  if (!g_methods.Set(method_id, coverage.get())) {
+    return;
+  }
+  coverage.release();
+  LOG(ERROR) << "mikrom coverage method:" << method->PrettyMethod() << " id:" << method_id
+             << " blocks:" << block_count;
+  std::call_once(g_writer_once, [] { std::thread(WriterLoop).detach(); });
+}
+
+MethodCoverage* Coverage::ForMethod(uint32_t method_id) {
+  return g_methods.Get(method_id);
+}
+
+}  // namespace mikrom
+}  // namespace art
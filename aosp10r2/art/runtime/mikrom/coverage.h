@@ -0,0 +1,80 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_COVERAGE_H_
+#define ART_RUNTIME_MIKROM_COVERAGE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "base/locks.h"
+#include "base/macros.h"
+
+namespace art {
+
+class ArtMethod;
+
+namespace mikrom {
+
+// Basic block coverage of one method traced in coverage mode. Block leaders are
+// computed once from the instructions in memory; executing an instruction only
+// costs a table load, plus an atomic or the first time a block is reached.
+class MethodCoverage {
+ public:
+  ALWAYS_INLINE void Visit(uint32_t dex_pc) {
+    if (LIKELY(dex_pc < insns_size_)) {
+      int32_t block = block_of_[dex_pc];
+      if (block >= 0) {
+        std::atomic<uint32_t>& word = bits_[block >> 5];
+        uint32_t mask = 1u << (block & 31);
+        if (UNLIKELY((word.load(std::memory_order_relaxed) & mask) == 0)) {
+          word.fetch_or(mask, std::memory_order_relaxed);
+          dirty_.store(true, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+  uint32_t BlockCount() const {
+    return block_count_;
+  }
+
+  uint32_t BitsWord(size_t index) const {
+    return bits_[index].load(std::memory_order_relaxed);
+  }
+
+  // Returns whether a new block was hit since the previous call.
+  bool TakeDirty() {
+    return dirty_.exchange(false, std::memory_order_relaxed);
+  }
+
+ private:
+  MethodCoverage() {}
+
+  uint32_t insns_size_ = 0;
+  uint32_t block_count_ = 0;
+  // dex_pc -> index of the block starting there, -1 inside a block.
+  std::unique_ptr<int32_t[]> block_of_;
+  std::unique_ptr<std::atomic<uint32_t>[]> bits_;
+  std::atomic<bool> dirty_{false};
+
+  friend class Coverage;
+};
+
+// Coverage mode (traceMode 1): instead of every instruction, methods matching
+// traceMethod record which basic blocks ran. The bitmaps are written to the trace
+// file as CoverageRecords every second while they change; mikromtrace coverage
+// maps them back to dex offsets and can export drcov.
+class Coverage {
+ public:
+  // Called once for every method SmaliTrace assigns |method_id| to.
+  static void Register(ArtMethod* method, uint32_t method_id) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Returns the coverage of |method_id|, or null if it is not registered (yet).
+  static MethodCoverage* ForMethod(uint32_t method_id);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_COVERAGE_H_
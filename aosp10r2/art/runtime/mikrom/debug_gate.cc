@@ -0,0 +1,162 @@
+// change mikrom
+#include "mikrom/debug_gate.h"
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <android-base/logging.h>
+
+#include "art_method-inl.h"
+#include "base/time_utils.h"
+#include "debugger.h"
+#include "mikrom/method_table.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-inl.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+// Waiters wake up this often to look for a debugger; a release wakes them at once.
+static constexpr int64_t kPollIntervalNs = MsToNs(100);
+
+enum Decision : uint32_t {
+  kPass = 0,
+  kWait = 1,
+};
+
+static std::atomic<bool> g_initialized{false};
+static std::string g_pattern;
+static uint64_t g_timeout_ns = 0;
+// TracerPid when the gate was armed, e.g. a packer's own tracer.
+static int g_armed_tracer_pid = 0;
+// Set when the first waiter arrives, 0 before that.
+static std::atomic<uint64_t> g_wait_start_ns{0};
+// 0 while closed, 1 once released. The futex word.
+static std::atomic<int32_t> g_open{0};
+// Decisions keyed by ArtMethod*.
+static PointerTable g_methods(14);
+
+// The value of |key| in /proc/<pid>/status, or -1 if it cannot be read: apps
+// cannot read the status of processes of other uids.
+static int ReadStatusField(const char* pid, const char* key) {
+  char path[64];
+  snprintf(path, sizeof(path), "/proc/%s/status", pid);
+  FILE* status = fopen(path, "re");
+  if (status == nullptr) {
+    return -1;
+  }
+  char line[128];
+  int value = -1;
+  size_t key_length = strlen(key);
+  while (fgets(line, sizeof(line), status) != nullptr) {
+    if (strncmp(line, key, key_length) == 0) {
+      value = atoi(line + key_length);
+      break;
+    }
+  }
+  fclose(status);
+  return value;
+}
+
+static int TracerPid() {
+  return ReadStatusField("self", "TracerPid:");
+}
+
+// A debugger that was not there when the gate was armed. A TracerPid that
+// changes only counts if the tracer is not our own child, which is how packers
+// ptrace their process to keep debuggers out. JDWP is asked directly, since
+// /proc/mikrom_mask hides TracerPid for masked targets.
+static bool DebuggerAttached() {
+  if (Dbg::IsDebuggerActive()) {
+    return true;
+  }
+  int tracer = TracerPid();
+  if (tracer <= 0 || tracer == g_armed_tracer_pid) {
+    return false;
+  }
+  std::string tracer_pid = std::to_string(tracer);
+  return ReadStatusField(tracer_pid.c_str(), "PPid:") != getpid();
+}
+
+static void FutexWait(int64_t timeout_ns) {
+  timespec timeout;
+  timeout.tv_sec = timeout_ns / INT64_C(1000000000);
+  timeout.tv_nsec = timeout_ns % INT64_C(1000000000);
+  syscall(SYS_futex, reinterpret_cast<int32_t*>(&g_open), FUTEX_WAIT_PRIVATE, 0, &timeout,
+          nullptr, 0);
+}
+
+static void Wait() {
+  uint64_t start = 0;
+  g_wait_start_ns.compare_exchange_strong(start, NanoTime(), std::memory_order_relaxed);
+  while (g_open.load(std::memory_order_acquire) == 0) {
+    if (DebuggerAttached()) {
+      DebugGate::Release("debugger attached");
+      break;
+    }
+    if (g_timeout_ns != 0 &&
+        NanoTime() - g_wait_start_ns.load(std::memory_order_relaxed) >= g_timeout_ns) {
+      DebugGate::Release("timeout");
+      break;
+    }
+    // Returns early on a release (FUTEX_WAKE), a signal or when g_open is already set.
+    FutexWait(kPollIntervalNs);
+  }
+}
+
+}  // namespace
+
+std::atomic<bool> DebugGate::armed_{false};
+
+void DebugGate::Init(const char* pattern, int timeout_seconds) {
+  // Readers use g_pattern without a lock, so a reloaded config does not re-arm the gate.
+  if (pattern == nullptr || pattern[0] == '\0' || g_initialized.exchange(true)) {
+    return;
+  }
+  g_pattern = pattern;
+  g_timeout_ns = timeout_seconds > 0 ? MsToNs(static_cast<uint64_t>(timeout_seconds) * 1000) : 0;
+  g_armed_tracer_pid = TracerPid();
+  LOG(ERROR) << "mikrom debug gate armed method:" << g_pattern << " timeout:" << timeout_seconds;
+  armed_.store(true, std::memory_order_release);
+}
+
+void DebugGate::Release(const char* reason) {
+  if (g_open.exchange(1, std::memory_order_acq_rel) != 0) {
+    return;
+  }
+  armed_.store(false, std::memory_order_relaxed);
+  syscall(SYS_futex, reinterpret_cast<int32_t*>(&g_open), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr,
+          nullptr, 0);
+  LOG(ERROR) << "mikrom debug gate released:" << reason;
+}
+
+void DebugGate::CheckSlow(Thread* self, ArtMethod* method) {
+  uint32_t decision;
+  if (!g_methods.Lookup(method, &decision)) {
+    std::string name = method->PrettyMethod();
+    decision = strstr(name.c_str(), g_pattern.c_str()) != nullptr ? kWait : kPass;
+    // A full table only costs a re-evaluation next time.
+    g_methods.Insert(method, &decision);
+  }
+  if (decision != kWait || g_open.load(std::memory_order_acquire) != 0) {
+    return;
+  }
+  LOG(ERROR) << "mikrom debug gate waiting in " << method->PrettyMethod() << " pid:" << getpid()
+             << " tid:" << self->GetTid();
+  // Suspended, so GC and the thread releasing the gate are not held up.
+  ScopedThreadSuspension sts(self, kWaitingForDebuggerToAttach);
+  Wait();
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,56 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_DEBUG_GATE_H_
+#define ART_RUNTIME_MIKROM_DEBUG_GATE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "base/locks.h"
+#include "base/macros.h"
+
+namespace art {
+
+class ArtMethod;
+class Thread;
+
+namespace mikrom {
+
+// sleepNativeMethod support: a native method whose PrettyMethod() contains the
+// configured string holds its caller on entry until a debugger can be attached.
+// The match is made once per ArtMethod and cached, so other native calls only
+// pay a load and a hash lookup, and nothing at all once the gate is open.
+//
+// Waiters block on a futex, suspended, and the gate opens for good as soon as a
+// JDWP debugger attaches, a new tracer that is not our own child shows up in
+// TracerPid, DexFile.releaseDebugGate() is called
+// (MikRomService.requestDebugRelease) or debugWaitTimeout seconds have passed,
+// if set. A target that root has added to /proc/mikrom_mask by hand reports
+// TracerPid 0, so a native debugger on it needs an explicit release; targets
+// are not added automatically, and unlisted ones show their tracer.
+class DebugGate {
+ public:
+  // Arms the gate for |pattern|; an empty pattern leaves it open. Only the
+  // first non-empty pattern counts, later configs do not re-arm it.
+  static void Init(const char* pattern, int timeout_seconds);
+
+  // Called on entry to a native method; returns at once unless |method| matches.
+  ALWAYS_INLINE static void Check(Thread* self, ArtMethod* method)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (UNLIKELY(armed_.load(std::memory_order_relaxed))) {
+      CheckSlow(self, method);
+    }
+  }
+
+  static void Release(const char* reason);
+
+ private:
+  static void CheckSlow(Thread* self, ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  static std::atomic<bool> armed_;
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_DEBUG_GATE_H_
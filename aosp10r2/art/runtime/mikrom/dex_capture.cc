@@ -0,0 +1,157 @@
+// change mikrom
+#include "mikrom/dex_capture.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+
+#include <android-base/logging.h>
+#include <android-base/properties.h>
+
+#include "dex/dex_file-inl.h"
+#include "mikrom/code_index.h"
+#include "thread_pool.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+static bool WriteFully(int fd, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    ssize_t n = TEMP_FAILURE_RETRY(write(fd, bytes, size));
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= n;
+  }
+  return true;
+}
+
+// Creates |path| exclusively, so a file of the same checksum is written once.
+static int CreateOnce(const char* path) {
+  int fd = open(path, O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0600);
+  if (fd < 0 && errno != EEXIST) {
+    PLOG(ERROR) << "mikrom DexCapture open " << path << " failed";
+  }
+  return fd;
+}
+
+class CaptureTask : public SelfDeletingTask {
+ public:
+  CaptureTask(const std::string& dir, const DexFile* dex_file, bool write_index)
+      : dir_(dir), dex_file_(dex_file), write_index_(write_index) {}
+
+  void Run(Thread*) override {
+    if (dex_file_->IsCompactDexFile()) {
+      // Opened from the output vdex of a background dexopt. Begin()..Size() of
+      // a CompactDex leaves out the shared data section, so it cannot be saved
+      // as a dex file; the APK dex was captured by the install dexopt.
+      LOG(INFO) << "mikrom DexCapture skips compact dex " << dex_file_->GetLocation();
+      return;
+    }
+    uint32_t checksum = dex_file_->GetHeader().checksum_;
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%08x_dexfile.dex", dir_.c_str(), checksum);
+    int fd = CreateOnce(path);
+    if (fd < 0) {
+      return;
+    }
+    bool ok = WriteFully(fd, dex_file_->Begin(), dex_file_->Size());
+    close(fd);
+    if (!ok) {
+      PLOG(ERROR) << "mikrom DexCapture write " << path << " failed";
+      unlink(path);
+      return;
+    }
+    LOG(INFO) << "mikrom DexCapture " << dex_file_->GetLocation() << " -> " << path;
+
+    snprintf(path, sizeof(path), "%s/%08x_classlist.txt", dir_.c_str(), checksum);
+    fd = CreateOnce(path);
+    if (fd < 0) {
+      return;
+    }
+    // Same format as the runtime dumps, one descriptor per line.
+    std::string list;
+    for (size_t i = 0; i < dex_file_->NumClassDefs(); ++i) {
+      list += dex_file_->GetClassDescriptor(dex_file_->GetClassDef(i));
+      list += '\n';
+    }
+    if (!WriteFully(fd, list.data(), list.size())) {
+      PLOG(ERROR) << "mikrom DexCapture write " << path << " failed";
+    }
+    close(fd);
+
+    if (write_index_) {
+      WriteIndex(checksum);
+    }
+  }
+
+ private:
+  void WriteIndex(uint32_t checksum) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%08x_codeindex.bin", dir_.c_str(), checksum);
+    int fd = CreateOnce(path);
+    if (fd < 0) {
+      return;
+    }
+    std::vector<uint8_t> index = CodeIndex::Build(*dex_file_);
+    bool ok = WriteFully(fd, index.data(), index.size());
+    close(fd);
+    if (!ok) {
+      // A partial index would hide methods from the dump.
+      PLOG(ERROR) << "mikrom DexCapture write " << path << " failed";
+      unlink(path);
+    }
+  }
+
+  const std::string dir_;
+  const DexFile* const dex_file_;
+  const bool write_index_;
+};
+
+}  // namespace
+
+bool DexCapture::Enabled() {
+  return android::base::GetBoolProperty(kEnableProperty, true);
+}
+
+std::string DexCapture::Dir(const std::string& package_name) {
+  return std::string(kRootDir) + "/" + package_name;
+}
+
+void DexCapture::Capture(Thread* self,
+                         const std::string& package_name,
+                         const std::vector<const DexFile*>& dex_files,
+                         size_t thread_count) {
+  if (package_name.empty() || dex_files.empty()) {
+    return;
+  }
+  // dex2oat runs as the app uid, so the directory and files are private to
+  // the app that reads the code index back.
+  std::string dir = Dir(package_name);
+  if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST) {
+    PLOG(ERROR) << "mikrom DexCapture mkdir " << dir << " failed";
+    return;
+  }
+  bool write_index = android::base::GetBoolProperty(kIndexProperty, true);
+  ThreadPool pool("Mikrom capture thread pool",
+                  std::max<size_t>(1u, std::min(thread_count, dex_files.size())));
+  for (const DexFile* dex_file : dex_files) {
+    pool.AddTask(self, new CaptureTask(dir, dex_file, write_index));
+  }
+  pool.StartWorkers(self);
+  pool.Wait(self, /* do_work= */ true, /* may_hold_locks= */ false);
+}
+
+}  // namespace mikrom
+}  // namespace art
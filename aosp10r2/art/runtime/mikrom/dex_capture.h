@@ -0,0 +1,50 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_DEX_CAPTURE_H_
+#define ART_RUNTIME_MIKROM_DEX_CAPTURE_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "base/locks.h"
+
+namespace art {
+
+class DexFile;
+class Thread;
+
+namespace mikrom {
+
+// Install time capture: dex2oat writes every input dex of a tuoke target, and
+// its class list, to /data/misc/mikrom/<package> before compiling it. dex2oat
+// may not write to external storage; the directory is created and labeled by
+// MikRomService, see system/sepolicy/private/mikrom.te. Shells that decrypt their payload before dexopt are caught
+// without any runtime cost. Files are named by the dex header checksum and an
+// existing file is never rewritten, so repeated dexopts only add new payloads.
+// A code item index (mikrom/code_index.h) of each dex is written beside it.
+class DexCapture {
+ public:
+  // Property that turns the capture off when set to false; on by default.
+  static constexpr const char* kEnableProperty = "persist.mikrom.dex2oat.capture";
+  // Property that turns the code item index off when set to false; on by default.
+  static constexpr const char* kIndexProperty = "persist.mikrom.dex2oat.codeindex";
+  // Parent of the per package directories.
+  static constexpr const char* kRootDir = "/data/misc/mikrom";
+
+  static bool Enabled();
+
+  // Directory the files of |package_name| are written to.
+  static std::string Dir(const std::string& package_name);
+
+  // Writes |dex_files| on a pool of |thread_count| workers and waits for them.
+  static void Capture(Thread* self,
+                      const std::string& package_name,
+                      const std::vector<const DexFile*>& dex_files,
+                      size_t thread_count) REQUIRES(!Locks::mutator_lock_);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_DEX_CAPTURE_H_
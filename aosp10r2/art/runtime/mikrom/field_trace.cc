@@ -0,0 +1,192 @@
+// change mikrom
+#include "mikrom/field_trace.h"
+
+#include <string>
+
+#include "art_field-inl.h"
+#include "art_method-inl.h"
+#include "class_linker-inl.h"
+#include "dex/dex_instruction-inl.h"
+#include "mikrom/trace_buffer.h"
+#include "mirror/object-inl.h"
+#include "mirror/string-inl.h"
+#include "runtime.h"
+#include "shadow_frame-inl.h"
+#include "thread-inl.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+static constexpr size_t kMaxStringLength = 1024;
+
+enum FieldOperand {
+  kNotFieldAccess,
+  kInstanceField,       // field@CCCC, receiver vB, value vA
+  kInstanceFieldQuick,  // offset@CCCC, receiver vB, value vA
+  kStaticField,         // field@BBBB, value vAA
+};
+
+static FieldOperand Classify(Instruction::Code opcode, FieldAccess* access) {
+  switch (opcode) {
+    case Instruction::IGET:
+    case Instruction::IGET_WIDE:
+    case Instruction::IGET_OBJECT:
+    case Instruction::IGET_BOOLEAN:
+    case Instruction::IGET_BYTE:
+    case Instruction::IGET_CHAR:
+    case Instruction::IGET_SHORT:
+      *access = kFieldRead;
+      return kInstanceField;
+    case Instruction::IPUT:
+    case Instruction::IPUT_WIDE:
+    case Instruction::IPUT_OBJECT:
+    case Instruction::IPUT_BOOLEAN:
+    case Instruction::IPUT_BYTE:
+    case Instruction::IPUT_CHAR:
+    case Instruction::IPUT_SHORT:
+      *access = kFieldWrite;
+      return kInstanceField;
+    case Instruction::IGET_QUICK:
+    case Instruction::IGET_WIDE_QUICK:
+    case Instruction::IGET_OBJECT_QUICK:
+    case Instruction::IGET_BOOLEAN_QUICK:
+    case Instruction::IGET_BYTE_QUICK:
+    case Instruction::IGET_CHAR_QUICK:
+    case Instruction::IGET_SHORT_QUICK:
+      *access = kFieldRead;
+      return kInstanceFieldQuick;
+    case Instruction::IPUT_QUICK:
+    case Instruction::IPUT_WIDE_QUICK:
+    case Instruction::IPUT_OBJECT_QUICK:
+    case Instruction::IPUT_BOOLEAN_QUICK:
+    case Instruction::IPUT_BYTE_QUICK:
+    case Instruction::IPUT_CHAR_QUICK:
+    case Instruction::IPUT_SHORT_QUICK:
+      *access = kFieldWrite;
+      return kInstanceFieldQuick;
+    case Instruction::SGET:
+    case Instruction::SGET_WIDE:
+    case Instruction::SGET_OBJECT:
+    case Instruction::SGET_BOOLEAN:
+    case Instruction::SGET_BYTE:
+    case Instruction::SGET_CHAR:
+    case Instruction::SGET_SHORT:
+      *access = kFieldRead;
+      return kStaticField;
+    case Instruction::SPUT:
+    case Instruction::SPUT_WIDE:
+    case Instruction::SPUT_OBJECT:
+    case Instruction::SPUT_BOOLEAN:
+    case Instruction::SPUT_BYTE:
+    case Instruction::SPUT_CHAR:
+    case Instruction::SPUT_SHORT:
+      *access = kFieldWrite;
+      return kStaticField;
+    default:
+      return kNotFieldAccess;
+  }
+}
+
+static uint32_t IdentityHash(ObjPtr<mirror::Object> object) REQUIRES_SHARED(Locks::mutator_lock_) {
+  return object == nullptr ? 0u : static_cast<uint32_t>(object->IdentityHashCode());
+}
+
+}  // namespace
+
+bool FieldTrace::Before(ShadowFrame& shadow_frame,
+                        const Instruction* inst,
+                        uint16_t inst_data,
+                        uint32_t* object_id,
+                        ArtField** field) {
+  FieldAccess access;
+  FieldOperand operand = Classify(inst->Opcode(inst_data), &access);
+  if (operand == kNotFieldAccess) {
+    return false;
+  }
+  *object_id = 0;
+  *field = nullptr;
+  if (operand != kStaticField) {
+    ObjPtr<mirror::Object> receiver = shadow_frame.GetVRegReference(inst->VRegB_22c(inst_data));
+    if (operand == kInstanceFieldQuick && receiver != nullptr) {
+      *field = ArtField::FindInstanceFieldWithOffset(receiver->GetClass(), inst->VRegC_22c());
+    }
+    // Last: hashing may inflate the lock word and suspend.
+    *object_id = IdentityHash(receiver);
+  }
+  return true;
+}
+
+void FieldTrace::After(Thread* self,
+                       ShadowFrame& shadow_frame,
+                       uint32_t method_id,
+                       uint32_t dex_pc,
+                       const Instruction* inst,
+                       uint16_t inst_data,
+                       uint32_t object_id,
+                       ArtField* quick_field) {
+  if (self->IsExceptionPending()) {
+    return;
+  }
+  FieldAccess access;
+  FieldOperand operand = Classify(inst->Opcode(inst_data), &access);
+  ArtMethod* method = shadow_frame.GetMethod();
+  ArtField* field = nullptr;
+  uint32_t value_reg;
+  if (operand == kStaticField) {
+    value_reg = inst->VRegA_21c(inst_data);
+    field = Runtime::Current()->GetClassLinker()->LookupResolvedField(
+        inst->VRegB_21c(), method, /* is_static= */ true);
+  } else {
+    value_reg = inst->VRegA_22c(inst_data);
+    if (operand == kInstanceField) {
+      field = Runtime::Current()->GetClassLinker()->LookupResolvedField(
+          inst->VRegC_22c(), method, /* is_static= */ false);
+    } else {
+      field = quick_field;
+    }
+  }
+  if (field == nullptr) {
+    return;
+  }
+
+  FieldRecord record;
+  record.header.type = kRecordField;
+  record.method_id = method_id;
+  record.dex_pc = dex_pc;
+  record.dex_checksum = field->GetDexFile()->GetHeader().checksum_;
+  record.field_idx = field->GetDexFieldIndex();
+  record.object_id = object_id;
+  record.access = access;
+  record.type = field->GetTypeAsPrimitiveType();
+  record.string_length = 0;
+  std::string string_value;
+  switch (field->GetTypeAsPrimitiveType()) {
+    case Primitive::kPrimLong:
+    case Primitive::kPrimDouble:
+      record.value = static_cast<uint64_t>(shadow_frame.GetVRegLong(value_reg));
+      break;
+    case Primitive::kPrimNot: {
+      ObjPtr<mirror::Object> value = shadow_frame.GetVRegReference(value_reg);
+      if (value != nullptr && value->IsString()) {
+        string_value = value->AsString()->ToModifiedUtf8();
+        if (string_value.size() > kMaxStringLength) {
+          string_value.resize(kMaxStringLength);
+        }
+        record.string_length = static_cast<uint16_t>(string_value.size());
+      }
+      // Last: hashing may inflate the lock word and suspend.
+      record.value = IdentityHash(value);
+      break;
+    }
+    default:
+      record.value = static_cast<uint32_t>(shadow_frame.GetVReg(value_reg));
+      break;
+  }
+  record.header.size = sizeof(record) + record.string_length;
+  TraceBuffer::Append(&record, sizeof(record), string_value.data(), record.string_length);
+}
+
+}  // namespace mikrom
+}  // namespace art
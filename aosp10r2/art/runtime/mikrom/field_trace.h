@@ -0,0 +1,52 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_FIELD_TRACE_H_
+#define ART_RUNTIME_MIKROM_FIELD_TRACE_H_
+
+#include <stdint.h>
+
+#include "base/locks.h"
+#include "base/macros.h"
+
+namespace art {
+
+class ArtField;
+class Instruction;
+class ShadowFrame;
+class Thread;
+
+namespace mikrom {
+
+// Field trace mode (traceMode 4): every iget/iput/sget/sput executed by a method
+// matching traceMethod is written as a FieldRecord with the field, the receiver's
+// identity hash and the value read or written (string contents included). Much
+// smaller than an instruction trace when only the data flow through fields is of
+// interest, e.g. a config being decrypted into an object.
+class FieldTrace {
+ public:
+  // Called before |inst| executes. Returns false if it is not a field access,
+  // otherwise fills |object_id| with the receiver's identity hash (0 for static
+  // fields or a null receiver), read now because the receiver register can be
+  // the destination of the instruction. For the quickened forms, which name the
+  // field by offset in the receiver's class, |field| is resolved now for the
+  // same reason; it is null otherwise.
+  static bool Before(ShadowFrame& shadow_frame,
+                     const Instruction* inst,
+                     uint16_t inst_data,
+                     uint32_t* object_id,
+                     ArtField** field) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Called after |inst| executed, records the access unless it threw.
+  static void After(Thread* self,
+                    ShadowFrame& shadow_frame,
+                    uint32_t method_id,
+                    uint32_t dex_pc,
+                    const Instruction* inst,
+                    uint16_t inst_data,
+                    uint32_t object_id,
+                    ArtField* quick_field) REQUIRES_SHARED(Locks::mutator_lock_);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_FIELD_TRACE_H_
@@ -0,0 +1,113 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_FRAME_TRACE_H_
+#define ART_RUNTIME_MIKROM_FRAME_TRACE_H_
+
+#include <stdint.h>
+
+#include "art_method.h"
+#include "base/macros.h"
+#include "mikrom/coverage.h"
+#include "mikrom/field_trace.h"
+#include "mikrom/sampling.h"
+#include "mikrom/smali_trace.h"
+
+namespace art {
+namespace mikrom {
+
+// What the switch interpreter records for one frame, decided once when the frame
+// starts executing so that the per-instruction cost for untraced methods stays a
+// single predictable branch.
+class FrameTrace {
+ public:
+  explicit FrameTrace(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_)
+      : method_id_(SmaliTrace::MethodId(method)) {
+    if (LIKELY(method_id_ == 0)) {
+      return;
+    }
+    int mode = ArtMethod::GetTraceMode();
+    if (mode == kTraceModeCoverage) {
+      coverage_ = Coverage::ForMethod(method_id_);
+      if (coverage_ == nullptr) {
+        // Not coverable (no code item or too many blocks).
+        method_id_ = 0;
+      }
+    } else if (mode == kTraceModeSampling) {
+      samples_ = Sampling::ForMethod(method_id_);
+      if (samples_ == nullptr) {
+        method_id_ = 0;
+        return;
+      }
+      sample_rate_ = Sampling::Rate();
+      countdown_ = Sampling::ThreadCountdown();
+      if (countdown_ == 0 || countdown_ > sample_rate_) {
+        countdown_ = sample_rate_;
+      }
+    } else if (mode == kTraceModeCalls) {
+      // Recorded by CallTrace on entry and exit only.
+      method_id_ = 0;
+    } else if (mode == kTraceModeFields) {
+      field_method_id_ = method_id_;
+      method_id_ = 0;
+    }
+  }
+
+  ~FrameTrace() {
+    if (samples_ != nullptr) {
+      Sampling::ThreadCountdown() = countdown_;
+    }
+  }
+
+  ALWAYS_INLINE void OnInstruction(uint32_t dex_pc) {
+    if (UNLIKELY(method_id_ != 0)) {
+      if (coverage_ != nullptr) {
+        coverage_->Visit(dex_pc);
+      } else if (samples_ != nullptr) {
+        if (--countdown_ == 0) {
+          countdown_ = sample_rate_;
+          samples_->Hit(dex_pc);
+        }
+      } else {
+        SmaliTrace::RecordInstruction(method_id_, dex_pc);
+      }
+    }
+  }
+
+  ALWAYS_INLINE void BeforeInstruction(ShadowFrame& shadow_frame,
+                                       const Instruction* inst,
+                                       uint16_t inst_data)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (UNLIKELY(field_method_id_ != 0) &&
+        FieldTrace::Before(shadow_frame, inst, inst_data, &field_object_id_, &field_)) {
+      field_inst_ = inst;
+      field_inst_data_ = inst_data;
+    }
+  }
+
+  ALWAYS_INLINE void AfterInstruction(Thread* self, ShadowFrame& shadow_frame, uint32_t dex_pc)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (UNLIKELY(field_inst_ != nullptr)) {
+      FieldTrace::After(self, shadow_frame, field_method_id_, dex_pc, field_inst_,
+                        field_inst_data_, field_object_id_, field_);
+      field_inst_ = nullptr;
+    }
+  }
+
+ private:
+  uint32_t method_id_;
+  MethodCoverage* coverage_ = nullptr;
+  MethodSamples* samples_ = nullptr;
+  uint32_t sample_rate_ = 0;
+  uint32_t countdown_ = 0;
+  uint32_t field_method_id_ = 0;
+  const Instruction* field_inst_ = nullptr;
+  uint16_t field_inst_data_ = 0;
+  uint32_t field_object_id_ = 0;
+  ArtField* field_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameTrace);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_FRAME_TRACE_H_
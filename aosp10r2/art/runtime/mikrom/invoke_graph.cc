@@ -0,0 +1,192 @@
+// change mikrom
+#include "mikrom/invoke_graph.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <android-base/logging.h>
+
+#include "art_method-inl.h"
+#include "class_root.h"
+#include "mikrom/jni_strings.h"
+#include "mikrom/trace_buffer.h"
+#include "mirror/method.h"
+#include "stack.h"
+#include "thread.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+static constexpr size_t kCapacity = 1u << 14;
+static constexpr int kSnapshotIntervalMs = 1000;
+
+struct Edge {
+  std::atomic<uint64_t> hash;  // 0 while the slot is free; stored last.
+  ArtMethod* caller;
+  ArtMethod* callee;
+  uint32_t caller_id;
+  uint32_t callee_id;
+  std::atomic<uint64_t> count;
+  uint64_t written_count;  // Guarded by g_dump_lock.
+};
+
+static std::atomic<Edge*> g_edges{nullptr};
+static std::mutex g_insert_lock;
+static size_t g_size = 0;  // Guarded by g_insert_lock.
+static std::mutex g_dump_lock;
+static std::once_flag g_writer_once;
+
+class CallerVisitor : public StackVisitor {
+ public:
+  explicit CallerVisitor(Thread* thread) REQUIRES_SHARED(Locks::mutator_lock_)
+      : StackVisitor(thread, nullptr, StackVisitor::StackWalkKind::kIncludeInlinedFrames),
+        reflect_method_(GetClassRoot<mirror::Method>()),
+        reflect_constructor_(GetClassRoot<mirror::Constructor>()) {}
+
+  bool VisitFrame() override REQUIRES_SHARED(Locks::mutator_lock_) {
+    ArtMethod* method = GetMethod();
+    // Method.invoke and Constructor.newInstance0 both reach the callee through
+    // InvokeMethod; the real caller is the frame above them.
+    if (method == nullptr ||
+        method->IsRuntimeMethod() ||
+        (method->IsNative() && (method->GetDeclaringClass() == reflect_method_ ||
+                                method->GetDeclaringClass() == reflect_constructor_))) {
+      return ++depth_ < InvokeGraph::kMaxCallerDepth;
+    }
+    caller_ = method;
+    return false;
+  }
+
+  ArtMethod* Caller() const { return caller_; }
+
+ private:
+  const ObjPtr<mirror::Class> reflect_method_;
+  const ObjPtr<mirror::Class> reflect_constructor_;
+  ArtMethod* caller_ = nullptr;
+  size_t depth_ = 0;
+};
+
+static uint64_t Hash(ArtMethod* caller, ArtMethod* callee) {
+  uint64_t h = reinterpret_cast<uintptr_t>(caller);
+  h = h * UINT64_C(0x9E3779B97F4A7C15) + reinterpret_cast<uintptr_t>(callee);
+  return (h ^ (h >> 29)) | 1u;
+}
+
+// The low bit of a hash is always set, so the slot comes from the bits above it.
+static size_t Slot(uint64_t hash) {
+  return static_cast<size_t>(hash >> 1) & (kCapacity - 1);
+}
+
+static Edge* Find(Edge* edges, uint64_t hash, ArtMethod* caller, ArtMethod* callee) {
+  for (size_t i = Slot(hash), probes = 0;
+       probes < kCapacity;
+       i = (i + 1) & (kCapacity - 1), ++probes) {
+    uint64_t current = edges[i].hash.load(std::memory_order_acquire);
+    if (current == 0) {
+      return nullptr;
+    }
+    if (current == hash && edges[i].caller == caller && edges[i].callee == callee) {
+      return &edges[i];
+    }
+  }
+  return nullptr;
+}
+
+static void WriteSnapshot() {
+  Edge* edges = g_edges.load(std::memory_order_acquire);
+  if (edges == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(g_dump_lock);
+  for (size_t i = 0; i < kCapacity; ++i) {
+    Edge& edge = edges[i];
+    if (edge.hash.load(std::memory_order_acquire) == 0) {
+      continue;
+    }
+    uint64_t count = edge.count.load(std::memory_order_relaxed);
+    if (count == edge.written_count) {
+      continue;
+    }
+    edge.written_count = count;
+    InvokeEdgeRecord record;
+    record.header.type = kRecordInvokeEdge;
+    record.header.size = sizeof(record);
+    record.edge_id = static_cast<uint32_t>(i);
+    record.caller_id = edge.caller_id;
+    record.callee_id = edge.callee_id;
+    record.count = count;
+    TraceBuffer::Append(&record, sizeof(record));
+  }
+}
+
+static void WriterLoop() {
+  while (true) {
+    usleep(kSnapshotIntervalMs * 1000);
+    WriteSnapshot();
+  }
+}
+
+// Slow path, once per edge: interns the names and claims a slot.
+static Edge* Insert(uint64_t hash, ArtMethod* caller, ArtMethod* callee)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  uint32_t caller_id = caller != nullptr ? JniStrings::Method(caller) : 0;
+  uint32_t callee_id = JniStrings::Method(callee);
+
+  std::lock_guard<std::mutex> guard(g_insert_lock);
+  Edge* edges = g_edges.load(std::memory_order_relaxed);
+  if (edges == nullptr) {
+    edges = static_cast<Edge*>(calloc(kCapacity, sizeof(Edge)));
+    if (edges == nullptr) {
+      return nullptr;
+    }
+    g_edges.store(edges, std::memory_order_release);
+    std::call_once(g_writer_once, [] { std::thread(WriterLoop).detach(); });
+    LOG(ERROR) << "mikrom invoke graph started";
+  }
+  Edge* edge = Find(edges, hash, caller, callee);
+  if (edge != nullptr) {
+    return edge;
+  }
+  if (g_size * 4 >= kCapacity * 3) {
+    return nullptr;
+  }
+  size_t i = Slot(hash);
+  while (edges[i].hash.load(std::memory_order_relaxed) != 0) {
+    i = (i + 1) & (kCapacity - 1);
+  }
+  edge = &edges[i];
+  edge->caller = caller;
+  edge->callee = callee;
+  edge->caller_id = caller_id;
+  edge->callee_id = callee_id;
+  edge->hash.store(hash, std::memory_order_release);
+  ++g_size;
+  return edge;
+}
+
+}  // namespace
+
+void InvokeGraph::Record(Thread* self, ArtMethod* callee) {
+  CallerVisitor visitor(self);
+  visitor.WalkStack();
+  ArtMethod* caller = visitor.Caller();
+  uint64_t hash = Hash(caller, callee);
+  Edge* edges = g_edges.load(std::memory_order_acquire);
+  Edge* edge = edges != nullptr ? Find(edges, hash, caller, callee) : nullptr;
+  if (UNLIKELY(edge == nullptr)) {
+    edge = Insert(hash, caller, callee);
+    if (edge == nullptr) {
+      return;
+    }
+  }
+  edge->count.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace mikrom
+}  // namespace art
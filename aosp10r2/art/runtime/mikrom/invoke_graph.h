@@ -0,0 +1,31 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_INVOKE_GRAPH_H_
+#define ART_RUNTIME_MIKROM_INVOKE_GRAPH_H_
+
+#include "base/locks.h"
+
+namespace art {
+
+class ArtMethod;
+class Thread;
+
+namespace mikrom {
+
+// isInvokePrint support: counts the calls going through InvokeWithArgArray
+// (reflection and JNI Call*Method) per caller -> callee edge. The caller is the
+// first managed frame of |self| found by a short stack walk, skipping
+// Method.invoke. Lookups of known edges are lock free; method names are written
+// once through JniStrings and the counters as cumulative InvokeEdgeRecords once a
+// second while they change. mikromtrace invokes prints the graph.
+class InvokeGraph {
+ public:
+  // Frames walked looking for the caller.
+  static constexpr size_t kMaxCallerDepth = 8;
+
+  static void Record(Thread* self, ArtMethod* callee) REQUIRES_SHARED(Locks::mutator_lock_);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_INVOKE_GRAPH_H_
@@ -0,0 +1,248 @@
+// change mikrom
+#include "mikrom/jni_data.h"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+#include <android-base/logging.h>
+
+#include "art_method.h"
+#include "base/time_utils.h"
+#include "base/utils.h"
+#include "mikrom/jni_strings.h"
+#include "mikrom/method_table.h"
+#include "mikrom/module_map.h"
+#include "mikrom/trace_format.h"
+
+namespace art {
+namespace mikrom {
+
+std::atomic<size_t> JniData::max_bytes_{0};
+
+namespace {
+
+// Must be a power of two and hold several kMaxDataBytes payloads.
+static constexpr size_t kQueueSize = 4 * 1024 * 1024;
+static constexpr int kWriteIntervalMs = 100;
+
+static std::atomic<uint32_t> g_sample_rate{1};
+static std::atomic<uint32_t> g_calls{0};
+// Content hashes already written.
+static PointerTable g_seen(16);
+
+// Serializes Init() calls of config reloads.
+static std::mutex g_init_lock;
+static int g_fd = -1;  // Guarded by g_init_lock until the writer thread starts.
+static uint8_t* g_queue = nullptr;
+// Producers reserve [g_head, g_head + size) under the lock and copy into it
+// without the lock. They commit in reservation order by advancing g_committed,
+// so the writer only ever sees complete chunks in [g_tail, g_committed).
+static std::mutex g_queue_lock;
+static uint64_t g_head = 0;  // Guarded by g_queue_lock.
+static std::atomic<uint64_t> g_committed{0};
+static std::atomic<uint64_t> g_tail{0};  // Written by the writer thread only.
+static std::atomic<uint32_t> g_dropped{0};
+static std::condition_variable g_wake_cond;
+
+// Copies |size| bytes to the queue at |pos|, wrapping around.
+static void CopyIn(uint64_t pos, const void* data, size_t size) {
+  const uint8_t* src = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    size_t offset = pos & (kQueueSize - 1);
+    size_t n = std::min(size, kQueueSize - offset);
+    memcpy(g_queue + offset, src, n);
+    src += n;
+    size -= n;
+    pos += n;
+  }
+}
+
+static void WriterLoop() {
+  while (true) {
+    uint64_t head;
+    {
+      std::unique_lock<std::mutex> lock(g_queue_lock);
+      g_wake_cond.wait_for(lock, std::chrono::milliseconds(kWriteIntervalMs));
+    }
+    head = g_committed.load(std::memory_order_acquire);
+    uint64_t tail = g_tail.load(std::memory_order_relaxed);
+    if (head == tail) {
+      continue;
+    }
+    // Producers only write past |head|, so [tail, head) is stable.
+    size_t begin = tail & (kQueueSize - 1);
+    size_t size = head - tail;
+    size_t first = std::min(size, kQueueSize - begin);
+    struct iovec iov[2];
+    iov[0].iov_base = g_queue + begin;
+    iov[0].iov_len = first;
+    iov[1].iov_base = g_queue;
+    iov[1].iov_len = size - first;
+    if (TEMP_FAILURE_RETRY(writev(g_fd, iov, 2)) < 0) {
+      PLOG(ERROR) << "mikrom JniData write failed";
+    }
+    g_tail.store(head, std::memory_order_release);
+  }
+}
+
+static bool OpenSideFile() {
+  const char* package_name = ArtMethod::GetPackageName();
+  char path[PATH_MAX];
+  snprintf(path, sizeof(path), "/sdcard/Android/data/%s/files/trace", package_name);
+  mkdir(path, 0777);
+  snprintf(path, sizeof(path), "/sdcard/Android/data/%s/files/trace/mikrom_%d.jnidata",
+           package_name, getpid());
+  int fd = open(path, O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0666);
+  if (fd < 0) {
+    PLOG(ERROR) << "mikrom JniData open " << path << " failed";
+    return false;
+  }
+  TraceFileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kTraceFileMagic;
+  header.version = kTraceVersion;
+  header.header_size = sizeof(header);
+  header.pid = getpid();
+  header.start_ns = NanoTime();
+  if (TEMP_FAILURE_RETRY(write(fd, &header, sizeof(header))) != sizeof(header)) {
+    PLOG(ERROR) << "mikrom JniData write header failed";
+    close(fd);
+    return false;
+  }
+  g_fd = fd;
+  LOG(ERROR) << "mikrom JniData writing to " << path;
+  return true;
+}
+
+static uint64_t ContentHash(const void* data, size_t length, size_t total_length) {
+  uint64_t h = std::hash<std::string_view>()(
+      std::string_view(static_cast<const char*>(data), length));
+  h ^= static_cast<uint64_t>(total_length) * UINT64_C(0x9E3779B97F4A7C15);
+  // 0 marks a free slot of g_seen.
+  return h | 1u;
+}
+
+// Whether a payload of |hash| was queued before. Two threads racing on a new
+// payload, or a full table, only cost writing it again.
+static bool Seen(uint64_t hash) {
+  uint32_t value;
+  return g_seen.Lookup(reinterpret_cast<const void*>(static_cast<uintptr_t>(hash)), &value);
+}
+
+// Called once the payload of |hash| has its place in the queue, so a dropped
+// payload is captured again on its next call.
+static void MarkSeen(uint64_t hash) {
+  uint32_t value = 1;
+  g_seen.Insert(reinterpret_cast<const void*>(static_cast<uintptr_t>(hash)), &value);
+}
+
+}  // namespace
+
+void JniData::Init(int max_bytes, int sample_rate) {
+  std::lock_guard<std::mutex> guard(g_init_lock);
+  if (max_bytes <= 0) {
+    max_bytes_.store(0, std::memory_order_relaxed);
+    return;
+  }
+  if (g_fd < 0) {
+    g_queue = static_cast<uint8_t*>(malloc(kQueueSize));
+    if (g_queue == nullptr || !OpenSideFile()) {
+      free(g_queue);
+      g_queue = nullptr;
+      return;
+    }
+    std::thread(WriterLoop).detach();
+  }
+  g_sample_rate.store(std::max(sample_rate, 1), std::memory_order_relaxed);
+  size_t limit = std::min(static_cast<size_t>(max_bytes), kMaxDataBytes);
+  // Publishes the queue and side file to Capture().
+  max_bytes_.store(limit, std::memory_order_release);
+  LOG(ERROR) << "mikrom JniData maxBytes:" << limit << " sampleRate:" << std::max(sample_rate, 1);
+}
+
+void JniData::Capture(const char* function, uintptr_t caller_pc, const void* data, size_t size) {
+  uint32_t sample_rate = g_sample_rate.load(std::memory_order_relaxed);
+  if (sample_rate > 1 &&
+      g_calls.fetch_add(1, std::memory_order_relaxed) % sample_rate != 0) {
+    return;
+  }
+  size_t max_bytes = max_bytes_.load(std::memory_order_acquire);
+  if (max_bytes == 0) {
+    return;
+  }
+  size_t length = std::min(size, max_bytes);
+  JniDataRecord record;
+  record.header.type = kRecordJniData;
+  record.function_id = JniStrings::Name(function);
+  record.length = static_cast<uint32_t>(length);
+  record.total_length = static_cast<uint32_t>(std::min<size_t>(size, UINT32_MAX));
+  record.content_hash = ContentHash(data, length, size);
+  record.flags = 0;
+  if (Seen(record.content_hash)) {
+    record.flags = kJniDataDuplicate;
+    record.length = 0;
+  }
+  record.header.size = sizeof(record) + record.length;
+  const ModuleMap::Module* module = ModuleMap::Find(caller_pc);
+  if (module != nullptr) {
+    record.caller_module = JniStrings::Module(module);
+    record.caller_pc = caller_pc - module->bias;
+  } else {
+    record.caller_module = 0;
+    record.caller_pc = caller_pc;
+  }
+  record.time_ns = NanoTime();
+
+  TraceChunkHeader chunk;
+  chunk.magic = kTraceChunkMagic;
+  chunk.tid = static_cast<uint32_t>(GetTid());
+  chunk.size = record.header.size;
+  size_t total = sizeof(chunk) + record.header.size;
+  uint64_t pos;
+  bool wake;
+  {
+    std::lock_guard<std::mutex> guard(g_queue_lock);
+    if (kQueueSize - (g_head - g_tail.load(std::memory_order_acquire)) < total) {
+      g_dropped.fetch_add(1, std::memory_order_relaxed);
+      g_wake_cond.notify_one();
+      return;
+    }
+    chunk.dropped = g_dropped.exchange(0, std::memory_order_relaxed);
+    pos = g_head;
+    g_head += total;
+    wake = g_head - g_tail.load(std::memory_order_relaxed) > kQueueSize / 2;
+  }
+  if (record.length != 0) {
+    MarkSeen(record.content_hash);
+  }
+  // The reserved bytes are not read by the writer before they are committed.
+  CopyIn(pos, &chunk, sizeof(chunk));
+  CopyIn(pos + sizeof(chunk), &record, sizeof(record));
+  CopyIn(pos + sizeof(chunk) + sizeof(record), data, record.length);
+  // Earlier reservations are at most one payload copy away from committing.
+  while (g_committed.load(std::memory_order_acquire) != pos) {
+    sched_yield();
+  }
+  g_committed.store(pos + total, std::memory_order_release);
+  if (wake) {
+    g_wake_cond.notify_one();
+  }
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,43 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_JNI_DATA_H_
+#define ART_RUNTIME_MIKROM_JNI_DATA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+namespace art {
+namespace mikrom {
+
+// Payload capture for the JNI trace: the bytes crossing NewStringUTF,
+// GetStringUTFChars, GetByteArrayElements and SetByteArrayRegion, cut to
+// jniDataMaxBytes, one call in jniDataSampleRate, with payloads already seen
+// (by content hash) written only once. The calling thread copies the capped bytes
+// into a bounded queue and returns; a writer thread drains the queue into
+// mikrom_<pid>.jnidata next to the trace. When the queue is full the payload is
+// dropped and counted. Decode with mikromtrace jnidata.
+class JniData {
+ public:
+  // Upper bound of jniDataMaxBytes.
+  static constexpr size_t kMaxDataBytes = 64 * 1024;
+
+  // Opens the side file the first time |max_bytes| is positive; later calls
+  // only change the limits, 0 stops the capture. Called before the tracing
+  // table is installed and again for every config version.
+  static void Init(int max_bytes, int sample_rate);
+
+  static bool Enabled() { return max_bytes_.load(std::memory_order_relaxed) != 0; }
+
+  // Captures |size| bytes at |data| for a call of |function|, a name literal,
+  // returning to |caller_pc|.
+  static void Capture(const char* function, uintptr_t caller_pc, const void* data, size_t size);
+
+ private:
+  static std::atomic<size_t> max_bytes_;
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_JNI_DATA_H_
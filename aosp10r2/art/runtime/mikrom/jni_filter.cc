@@ -0,0 +1,160 @@
+// change mikrom
+#include "mikrom/jni_filter.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <vector>
+
+#include <android-base/logging.h>
+#include <android-base/strings.h>
+
+#include "art_field-inl.h"
+#include "art_method-inl.h"
+#include "jni/jni_internal.h"
+#include "mikrom/method_table.h"
+#include "mikrom/module_map.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+enum Decision : uint32_t {
+  kSkipped = 0,
+  kTraced = 1,
+};
+
+// The lists of one config version and the decisions made for them. A reload
+// publishes a new state; the replaced one is kept, since calls in flight may
+// still be reading it, and reloads are rare.
+struct FilterState {
+  std::vector<std::string> libs;
+  std::vector<std::string> methods;
+  bool unknown_traced = true;
+  // Decisions keyed by ModuleMap::Module::name_id and by jmethodID/jfieldID.
+  PointerTable modules{/* capacity_log2= */ 10, /* max_capacity_log2= */ 16};
+  PointerTable targets{/* capacity_log2= */ 16, /* max_capacity_log2= */ 22};
+};
+
+static std::atomic<FilterState*> g_state{nullptr};
+// Caller pcs outside any module that already forced a module map rebuild.
+static PointerTable g_unknown_pcs(/* capacity_log2= */ 10, /* max_capacity_log2= */ 16);
+
+static std::vector<std::string> ParseList(const std::string& list) {
+  std::vector<std::string> patterns;
+  for (std::string& pattern : android::base::Split(list, ",\n")) {
+    pattern = android::base::Trim(pattern);
+    if (!pattern.empty()) {
+      patterns.push_back(std::move(pattern));
+    }
+  }
+  return patterns;
+}
+
+static bool Matches(const std::vector<std::string>& patterns, const char* name) {
+  if (patterns.empty()) {
+    return true;
+  }
+  for (const std::string& pattern : patterns) {
+    if (strstr(name, pattern.c_str()) != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Caches the decision for |key|. A full table only costs a re-evaluation next time.
+static bool Remember(PointerTable* table, const void* key, bool traced) {
+  uint32_t value = traced ? kTraced : kSkipped;
+  table->Insert(key, &value);
+  return value == kTraced;
+}
+
+static bool AcceptCaller(FilterState* state, uintptr_t caller_pc) {
+  if (state->libs.empty()) {
+    return true;
+  }
+  const ModuleMap::Module* module = ModuleMap::Find(caller_pc);
+  if (module == nullptr) {
+    // Find() rescans at most every kRefreshIntervalMs, so a library dlopen()ed
+    // just now, e.g. running its JNI_OnLoad, misses. Rebuild once per such pc
+    // before calling it unknown; code in anonymous memory keeps missing.
+    const void* pc_key = reinterpret_cast<const void*>(caller_pc);
+    uint32_t seen = 1;
+    if (!g_unknown_pcs.Lookup(pc_key, &seen) && g_unknown_pcs.Insert(pc_key, &seen)) {
+      module = ModuleMap::FindFresh(caller_pc);
+    }
+    if (module == nullptr) {
+      return state->unknown_traced;
+    }
+  }
+  const void* key = reinterpret_cast<const void*>(static_cast<uintptr_t>(module->name_id));
+  uint32_t decision;
+  if (LIKELY(state->modules.Lookup(key, &decision))) {
+    return decision == kTraced;
+  }
+  bool traced = Matches(state->libs, module->name.c_str());
+  // Logged when the decision is first added, not on every call of a module
+  // that could not be cached.
+  uint32_t value = traced ? kTraced : kSkipped;
+  if (state->modules.Insert(key, &value)) {
+    LOG(ERROR) << "mikrom jni filter module:" << module->name << " traced:" << traced;
+  }
+  return traced;
+}
+
+static bool AcceptTarget(FilterState* state,
+                         JNIEnv* env,
+                         JniProfile::TargetKind kind,
+                         const void* target) REQUIRES(!Locks::mutator_lock_) {
+  if (state->methods.empty() || kind == JniProfile::kNoTarget) {
+    return true;
+  }
+  if (target == nullptr) {
+    return false;
+  }
+  uint32_t decision;
+  if (LIKELY(state->targets.Lookup(target, &decision))) {
+    return decision == kTraced;
+  }
+  std::string name;
+  {
+    ScopedObjectAccess soa(env);
+    if (kind == JniProfile::kMethodTarget) {
+      name = jni::DecodeArtMethod(reinterpret_cast<jmethodID>(const_cast<void*>(target)))
+          ->PrettyMethod();
+    } else {
+      name = jni::DecodeArtField(reinterpret_cast<jfieldID>(const_cast<void*>(target)))
+          ->PrettyField();
+    }
+  }
+  return Remember(&state->targets, target, Matches(state->methods, name.c_str()));
+}
+
+}  // namespace
+
+void JniFilter::Init(const std::string& libs, const std::string& methods) {
+  FilterState* state = new FilterState();
+  state->libs = ParseList(libs);
+  state->methods = ParseList(methods);
+  state->unknown_traced = Matches(state->libs, "<unknown>");
+  g_state.store(state, std::memory_order_release);
+  LOG(ERROR) << "mikrom jni filter libs:" << android::base::Join(state->libs, ',')
+             << " methods:" << android::base::Join(state->methods, ',');
+}
+
+bool JniFilter::Accept(JNIEnv* env,
+                       uintptr_t caller_pc,
+                       JniProfile::TargetKind kind,
+                       const void* target) {
+  FilterState* state = g_state.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    return true;
+  }
+  return AcceptCaller(state, caller_pc) && AcceptTarget(state, env, kind, target);
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,42 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_JNI_FILTER_H_
+#define ART_RUNTIME_MIKROM_JNI_FILTER_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/locks.h"
+#include "jni.h"
+#include "mikrom/jni_profile.h"
+
+namespace art {
+namespace mikrom {
+
+// Narrows isJNIMethodPrint down to the calls made from the modules listed in
+// jniTraceLibs and to the methods and fields listed in jniTraceMethods. Both are
+// lists of substrings separated by ',' or newlines, matched against the module
+// path and against PrettyMethod()/PrettyField(); an empty list matches everything
+// and calls without a method or field (FindClass, NewStringUTF, ...) only go
+// through the library filter. Code outside any module is named "<unknown>".
+//
+// The decision is made once per module path and once per jmethodID/jfieldID for
+// each config version, and cached in lock free tables, so a call that is
+// filtered out costs a binary search and two hash lookups.
+class JniFilter {
+ public:
+  // Parses the lists and starts over with no decisions made. Called before the
+  // tracing table is installed and again for every config version.
+  static void Init(const std::string& libs, const std::string& methods);
+
+  // Whether the call of a JNI function on |target| returning to |caller_pc| is traced.
+  static bool Accept(JNIEnv* env,
+                     uintptr_t caller_pc,
+                     JniProfile::TargetKind kind,
+                     const void* target) REQUIRES(!Locks::mutator_lock_);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_JNI_FILTER_H_
@@ -0,0 +1,214 @@
+// change mikrom
+#include "mikrom/jni_profile.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <android-base/logging.h>
+
+#include "art_field-inl.h"
+#include "art_method-inl.h"
+#include "base/bit_utils.h"
+#include "jni/jni_internal.h"
+#include "mikrom/jni_strings.h"
+#include "mikrom/module_map.h"
+#include "mikrom/trace_buffer.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+static constexpr size_t kCapacity = 1u << 13;
+static constexpr int kSnapshotIntervalMs = 1000;
+
+struct Entry {
+  std::atomic<uint64_t> hash;  // 0 while the slot is free; stored last.
+  // ModuleMap::Module::name_id of the caller, 0 outside any module. Modules are
+  // rebuilt on every dlopen, so their pointers would split an entry in many.
+  uint32_t module;
+  const char* function;
+  const void* target;
+  uint32_t function_id;
+  uint32_t target_id;
+  uint32_t caller_module;
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> total_ns;
+  std::atomic<uint32_t> latency[kJniLatencyBuckets];
+  uint64_t written_count;  // Guarded by g_dump_lock.
+};
+
+static std::atomic<Entry*> g_entries{nullptr};
+static std::mutex g_insert_lock;
+static size_t g_size = 0;  // Guarded by g_insert_lock.
+static std::mutex g_dump_lock;
+static std::once_flag g_writer_once;
+
+static uint64_t Hash(uint32_t module, const char* function, const void* target) {
+  uint64_t h = module;
+  h = h * UINT64_C(0x9E3779B97F4A7C15) + reinterpret_cast<uintptr_t>(function);
+  h = h * UINT64_C(0x9E3779B97F4A7C15) + reinterpret_cast<uintptr_t>(target);
+  return (h ^ (h >> 29)) | 1u;
+}
+
+static bool Matches(const Entry& entry,
+                    uint64_t hash,
+                    uint32_t module,
+                    const char* function,
+                    const void* target) {
+  return entry.hash.load(std::memory_order_acquire) == hash &&
+      entry.module == module &&
+      entry.function == function &&
+      entry.target == target;
+}
+
+static Entry* Find(Entry* entries,
+                   uint64_t hash,
+                   uint32_t module,
+                   const char* function,
+                   const void* target) {
+  for (size_t i = hash & (kCapacity - 1), probes = 0;
+       probes < kCapacity;
+       i = (i + 1) & (kCapacity - 1), ++probes) {
+    if (entries[i].hash.load(std::memory_order_acquire) == 0) {
+      return nullptr;
+    }
+    if (Matches(entries[i], hash, module, function, target)) {
+      return &entries[i];
+    }
+  }
+  return nullptr;
+}
+
+static void WriteSnapshot() {
+  Entry* entries = g_entries.load(std::memory_order_acquire);
+  if (entries == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(g_dump_lock);
+  for (size_t i = 0; i < kCapacity; ++i) {
+    Entry& entry = entries[i];
+    if (entry.hash.load(std::memory_order_acquire) == 0) {
+      continue;
+    }
+    uint64_t count = entry.count.load(std::memory_order_relaxed);
+    if (count == entry.written_count) {
+      continue;
+    }
+    entry.written_count = count;
+    JniProfileRecord record;
+    record.header.type = kRecordJniProfile;
+    record.header.size = sizeof(record);
+    record.entry_id = static_cast<uint32_t>(i);
+    record.function_id = entry.function_id;
+    record.target_id = entry.target_id;
+    record.caller_module = entry.caller_module;
+    record.count = count;
+    record.total_ns = entry.total_ns.load(std::memory_order_relaxed);
+    for (size_t b = 0; b < kJniLatencyBuckets; ++b) {
+      record.latency[b] = entry.latency[b].load(std::memory_order_relaxed);
+    }
+    TraceBuffer::Append(&record, sizeof(record));
+  }
+}
+
+static void WriterLoop() {
+  while (true) {
+    usleep(kSnapshotIntervalMs * 1000);
+    WriteSnapshot();
+  }
+}
+
+// Slow path, once per key: resolves the names and claims a slot.
+static Entry* Insert(JNIEnv* env,
+                     uint64_t hash,
+                     const ModuleMap::Module* module,
+                     const char* function,
+                     JniProfile::TargetKind kind,
+                     const void* target) REQUIRES(!Locks::mutator_lock_) {
+  uint32_t target_id = 0;
+  if (kind != JniProfile::kNoTarget) {
+    ScopedObjectAccess soa(env);
+    void* id = const_cast<void*>(target);
+    target_id = kind == JniProfile::kMethodTarget
+        ? JniStrings::Method(jni::DecodeArtMethod(static_cast<jmethodID>(id)))
+        : JniStrings::Field(jni::DecodeArtField(static_cast<jfieldID>(id)));
+  }
+  uint32_t function_id = JniStrings::Name(function);
+  uint32_t caller_module = module != nullptr ? JniStrings::Module(module) : 0;
+
+  std::lock_guard<std::mutex> guard(g_insert_lock);
+  Entry* entries = g_entries.load(std::memory_order_relaxed);
+  if (entries == nullptr) {
+    entries = static_cast<Entry*>(calloc(kCapacity, sizeof(Entry)));
+    if (entries == nullptr) {
+      return nullptr;
+    }
+    g_entries.store(entries, std::memory_order_release);
+    std::call_once(g_writer_once, [] { std::thread(WriterLoop).detach(); });
+    LOG(ERROR) << "mikrom jni profile started";
+  }
+  uint32_t module_key = module != nullptr ? module->name_id : 0;
+  Entry* entry = Find(entries, hash, module_key, function, target);
+  if (entry != nullptr) {
+    return entry;
+  }
+  if (g_size * 4 >= kCapacity * 3) {
+    return nullptr;
+  }
+  size_t i = hash & (kCapacity - 1);
+  while (entries[i].hash.load(std::memory_order_relaxed) != 0) {
+    i = (i + 1) & (kCapacity - 1);
+  }
+  entry = &entries[i];
+  entry->module = module_key;
+  entry->function = function;
+  entry->target = target;
+  entry->function_id = function_id;
+  entry->target_id = target_id;
+  entry->caller_module = caller_module;
+  entry->hash.store(hash, std::memory_order_release);
+  ++g_size;
+  return entry;
+}
+
+}  // namespace
+
+void JniProfile::Record(JNIEnv* env,
+                        const char* function,
+                        TargetKind kind,
+                        const void* target,
+                        uintptr_t caller_pc,
+                        uint64_t latency_ns) {
+  const ModuleMap::Module* module = ModuleMap::Find(caller_pc);
+  uint32_t module_key = module != nullptr ? module->name_id : 0;
+  uint64_t hash = Hash(module_key, function, target);
+  Entry* entries = g_entries.load(std::memory_order_acquire);
+  Entry* entry = entries != nullptr ? Find(entries, hash, module_key, function, target) : nullptr;
+  if (UNLIKELY(entry == nullptr)) {
+    entry = Insert(env, hash, module, function, kind, target);
+    if (entry == nullptr) {
+      return;
+    }
+  }
+  size_t bucket = latency_ns == 0
+      ? 0u
+      : std::min<size_t>(kJniLatencyBuckets - 1, 64 - CLZ(latency_ns));
+  entry->count.fetch_add(1, std::memory_order_relaxed);
+  entry->total_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+  entry->latency[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void JniProfile::Dump() {
+  WriteSnapshot();
+  TraceBuffer::Flush();
+}
+
+}  // namespace mikrom
+}  // namespace art
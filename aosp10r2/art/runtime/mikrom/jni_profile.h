@@ -0,0 +1,41 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_JNI_PROFILE_H_
+#define ART_RUNTIME_MIKROM_JNI_PROFILE_H_
+
+#include <stdint.h>
+
+#include "base/locks.h"
+#include "jni.h"
+
+namespace art {
+namespace mikrom {
+
+// JNI profile mode (jniTraceMode 1): instead of writing every call, the tracing
+// table counts calls per (caller module, JNI function, jmethodID/jfieldID) in a
+// fixed size lock free hash map, along with a log2 histogram of their latency.
+// The counters are written to the trace as JniProfileRecords once a second while
+// they change, and on demand through Dump(). mikromtrace jniprofile prints them.
+class JniProfile {
+ public:
+  enum TargetKind {
+    kNoTarget,
+    kMethodTarget,
+    kFieldTarget,
+  };
+
+  // Counts one call of |function|, a name literal, returning to |caller_pc|.
+  static void Record(JNIEnv* env,
+                     const char* function,
+                     TargetKind kind,
+                     const void* target,
+                     uintptr_t caller_pc,
+                     uint64_t latency_ns) REQUIRES(!Locks::mutator_lock_);
+
+  // Writes the entries changed since the last snapshot and flushes the trace.
+  static void Dump();
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_JNI_PROFILE_H_
@@ -0,0 +1,264 @@
+// change mikrom
+#include "mikrom/jni_strings.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <android-base/logging.h>
+
+#include "art_field-inl.h"
+#include "art_method-inl.h"
+#include "mikrom/method_table.h"
+#include "mikrom/trace_buffer.h"
+#include "mirror/string-inl.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+// Names by pointer. Contents by a hash of the bytes, probed again with another
+// key when a stored string with that hash turns out to differ.
+static PointerTable gNames(/* capacity_log2= */ 16, /* max_capacity_log2= */ 22);
+static PointerTable gStrings(/* capacity_log2= */ 16, /* max_capacity_log2= */ 22);
+static std::atomic<uint32_t> gNextStringId{1};
+static std::atomic<bool> gFullLogged{false};
+static std::atomic<bool> gCapLogged{false};
+
+static constexpr size_t kMaxProbes = 8;
+
+// Bytes of the strings in gStrings by string id, compared on every hash hit.
+// Chunks are allocated on demand and never freed, so readers take no lock.
+struct StoredString {
+  uint32_t length;
+  char data[1];
+};
+static constexpr uint32_t kChunkBits = 12;
+static constexpr uint32_t kMaxChunks = 1024;
+static std::atomic<std::atomic<StoredString*>*> gStored[kMaxChunks];
+static std::mutex gStoreLock;
+// Bytes malloc'd for StoredStrings, guarded by gStoreLock. Past kMaxStoredBytes
+// only names are added; argument contents that are not in the table yet get id 0.
+static size_t gStoredBytes = 0;
+
+static StoredString* Stored(uint32_t id) {
+  std::atomic<StoredString*>* chunk =
+      (id >> kChunkBits) < kMaxChunks ? gStored[id >> kChunkBits].load(std::memory_order_acquire)
+                                      : nullptr;
+  return chunk == nullptr ? nullptr
+                          : chunk[id & ((1u << kChunkBits) - 1)].load(std::memory_order_acquire);
+}
+
+// Caller holds gStoreLock.
+static bool Store(uint32_t id, const char* data, size_t length) {
+  if ((id >> kChunkBits) >= kMaxChunks) {
+    return false;
+  }
+  std::atomic<StoredString*>* chunk = gStored[id >> kChunkBits].load(std::memory_order_relaxed);
+  if (chunk == nullptr) {
+    chunk = static_cast<std::atomic<StoredString*>*>(
+        calloc(1u << kChunkBits, sizeof(std::atomic<StoredString*>)));
+    if (chunk == nullptr) {
+      return false;
+    }
+    gStored[id >> kChunkBits].store(chunk, std::memory_order_release);
+  }
+  StoredString* stored = static_cast<StoredString*>(malloc(sizeof(StoredString) + length));
+  if (stored == nullptr) {
+    return false;
+  }
+  gStoredBytes += sizeof(StoredString) + length;
+  stored->length = static_cast<uint32_t>(length);
+  memcpy(stored->data, data, length);
+  chunk[id & ((1u << kChunkBits) - 1)].store(stored, std::memory_order_release);
+  return true;
+}
+
+static bool Matches(uint32_t id, const char* data, size_t length) {
+  StoredString* stored = Stored(id);
+  return stored != nullptr && stored->length == length && memcmp(stored->data, data, length) == 0;
+}
+
+static void LogFull() {
+  if (!gFullLogged.exchange(true)) {
+    LOG(ERROR) << "mikrom JniStrings table is full, new strings are written as id 0";
+  }
+}
+
+static void LogCapped() {
+  if (!gCapLogged.exchange(true)) {
+    LOG(ERROR) << "mikrom JniStrings stored " << gStoredBytes
+               << " bytes, new string arguments are written as id 0";
+  }
+}
+
+static void EmitString(uint32_t id, const char* data, size_t length) {
+  JniStringRecord record;
+  record.header.type = kRecordJniString;
+  record.header.size = sizeof(record) + length;
+  record.string_id = id;
+  record.length = static_cast<uint32_t>(length);
+  TraceBuffer::Append(&record, sizeof(record), data, length);
+}
+
+// Gives |key| the next string id and writes |data| under it, unless another
+// thread got there first. Returns 0, writing nothing, when the table is full.
+static uint32_t AddString(PointerTable* table, const void* key, const char* data, size_t length) {
+  uint32_t id = gNextStringId.fetch_add(1, std::memory_order_relaxed);
+  uint32_t value = id;
+  if (!table->Insert(key, &value)) {
+    LogFull();
+    return 0;
+  }
+  if (value == id) {
+    EmitString(id, data, length);
+  }
+  return value;
+}
+
+// Appends |c| to |out| in modified UTF-8 unless that would pass |limit|:
+// U+0000 takes two bytes and surrogates are encoded one by one, as in dex files.
+static bool AppendModifiedUtf8(uint16_t c, char** out, const char* limit) {
+  char* p = *out;
+  if (c != 0 && c < 0x80) {
+    if (limit - p < 1) {
+      return false;
+    }
+    *p++ = static_cast<char>(c);
+  } else if (c < 0x800) {
+    if (limit - p < 2) {
+      return false;
+    }
+    *p++ = static_cast<char>(0xc0 | (c >> 6));
+    *p++ = static_cast<char>(0x80 | (c & 0x3f));
+  } else {
+    if (limit - p < 3) {
+      return false;
+    }
+    *p++ = static_cast<char>(0xe0 | (c >> 12));
+    *p++ = static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+    *p++ = static_cast<char>(0x80 | (c & 0x3f));
+  }
+  *out = p;
+  return true;
+}
+
+// Id of the string |data|, added to gStrings if it is new. |is_name| strings are
+// added past kMaxStoredBytes too.
+static uint32_t Intern(const char* data, size_t length, bool is_name) {
+  length = std::min(length, JniStrings::kMaxStringLength);
+  uint64_t hash = std::hash<std::string_view>()(std::string_view(data, length));
+  hash ^= static_cast<uint64_t>(length) << 32;
+  for (size_t probe = 0; probe < kMaxProbes; ++probe) {
+    // 0 marks a free slot.
+    const void* key = reinterpret_cast<const void*>(
+        static_cast<uintptr_t>(hash + probe * UINT64_C(0x9E3779B97F4A7C15)) | 1u);
+    uint32_t id;
+    if (LIKELY(gStrings.Lookup(key, &id))) {
+      if (LIKELY(Matches(id, data, length))) {
+        return id;
+      }
+      continue;
+    }
+    std::lock_guard<std::mutex> guard(gStoreLock);
+    if (gStrings.Lookup(key, &id)) {
+      // Added meanwhile.
+      if (Matches(id, data, length)) {
+        return id;
+      }
+      continue;
+    }
+    if (!is_name && gStoredBytes + sizeof(StoredString) + length > JniStrings::kMaxStoredBytes) {
+      LogCapped();
+      return 0;
+    }
+    id = gNextStringId.fetch_add(1, std::memory_order_relaxed);
+    if (!Store(id, data, length)) {
+      LogFull();
+      return 0;
+    }
+    uint32_t value = id;
+    if (!gStrings.Insert(key, &value)) {
+      LogFull();
+      return 0;
+    }
+    EmitString(id, data, length);
+    return id;
+  }
+  // Only reachable with kMaxProbes different strings on one hash.
+  LogFull();
+  return 0;
+}
+
+}  // namespace
+
+uint32_t JniStrings::String(ObjPtr<mirror::String> string) {
+  int32_t length = string->GetLength();
+  if (string->IsCompressed()) {
+    // Compressed strings only hold ASCII, which is its own modified UTF-8.
+    return Contents(reinterpret_cast<const char*>(string->GetValueCompressed()),
+                    static_cast<size_t>(length));
+  }
+  char buffer[kMaxStringLength];
+  char* out = buffer;
+  const uint16_t* chars = string->GetValue();
+  for (int32_t i = 0; i < length; ++i) {
+    if (!AppendModifiedUtf8(chars[i], &out, buffer + sizeof(buffer))) {
+      break;
+    }
+  }
+  return Contents(buffer, out - buffer);
+}
+
+uint32_t JniStrings::Contents(const char* data, size_t length) {
+  return Intern(data, length, /* is_name= */ false);
+}
+
+uint32_t JniStrings::Name(const char* name) {
+  uint32_t id;
+  if (LIKELY(gNames.Lookup(name, &id))) {
+    return id;
+  }
+  return AddString(&gNames, name, name, strlen(name));
+}
+
+uint32_t JniStrings::Method(ArtMethod* method) {
+  uint32_t id;
+  if (LIKELY(gNames.Lookup(method, &id))) {
+    return id;
+  }
+  std::string name = method->PrettyMethod();
+  return AddString(&gNames, method, name.data(), name.size());
+}
+
+uint32_t JniStrings::Field(ArtField* field) {
+  uint32_t id;
+  if (LIKELY(gNames.Lookup(field, &id))) {
+    return id;
+  }
+  std::string name = ArtField::PrettyField(field);
+  return AddString(&gNames, field, name.data(), name.size());
+}
+
+uint32_t JniStrings::Module(const ModuleMap::Module* module) {
+  uint32_t id;
+  if (LIKELY(gNames.Lookup(module, &id))) {
+    return id;
+  }
+  // By contents, so that rebuilding the module map does not write the paths again.
+  id = Intern(module->name.data(), module->name.size(), /* is_name= */ true);
+  if (id != 0) {
+    gNames.Insert(module, &id);
+  }
+  return id;
+}
+
+}  // namespace mikrom
+}  // namespace art
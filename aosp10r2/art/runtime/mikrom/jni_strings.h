@@ -0,0 +1,52 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_JNI_STRINGS_H_
+#define ART_RUNTIME_MIKROM_JNI_STRINGS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/locks.h"
+#include "mikrom/module_map.h"
+#include "obj_ptr.h"
+
+namespace art {
+
+class ArtField;
+class ArtMethod;
+
+namespace mirror {
+class String;
+}  // namespace mirror
+
+namespace mikrom {
+
+// String table of the JNI trace. Each string is written once as a JniStringRecord
+// and referred to by id afterwards. Names are keyed by the JNI function name
+// literal, ArtMethod*, ArtField* or ModuleMap::Module*, other strings by a hash of
+// their contents, with the stored bytes compared on a hit so that colliding
+// strings get ids of their own. Lookups are lock free. Id 0 means the string
+// could not be added because the tables are full, or, for String() and
+// Contents(), because kMaxStoredBytes of strings are already kept.
+class JniStrings {
+ public:
+  // Strings longer than this are cut.
+  static constexpr size_t kMaxStringLength = 1024;
+  // Bytes kept for comparing strings by contents. Module names are still added
+  // past it, so every call keeps its caller; new string arguments are not.
+  static constexpr size_t kMaxStoredBytes = 64u << 20;
+
+  static uint32_t Contents(const char* data, size_t length);
+  // The first kMaxStringLength bytes of |string| in modified UTF-8, encoded from
+  // the compressed or UTF-16 value in place without allocating.
+  static uint32_t String(ObjPtr<mirror::String> string) REQUIRES_SHARED(Locks::mutator_lock_);
+  // |name| must outlive the process, e.g. a literal.
+  static uint32_t Name(const char* name);
+  static uint32_t Method(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_);
+  static uint32_t Field(ArtField* field) REQUIRES_SHARED(Locks::mutator_lock_);
+  static uint32_t Module(const ModuleMap::Module* module);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_JNI_STRINGS_H_
@@ -0,0 +1,663 @@
+// change mikrom
+#include "mikrom/jni_trace.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+#include <mutex>
+#include <string>
+
+#include <android-base/logging.h>
+
+#include "art_field-inl.h"
+#include "art_method-inl.h"
+#include "base/casts.h"
+#include "base/time_utils.h"
+#include "jni/check_jni.h"
+#include "jni/jni_env_ext.h"
+#include "jni/jni_internal.h"
+#include "mikrom/jni_data.h"
+#include "mikrom/jni_filter.h"
+#include "mikrom/jni_profile.h"
+#include "mikrom/jni_strings.h"
+#include "mikrom/module_map.h"
+#include "mikrom/package_config.h"
+#include "mikrom/trace_buffer.h"
+#include "mirror/object-inl.h"
+#include "mirror/string-inl.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-inl.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+// Arguments past this are not recorded.
+static constexpr size_t kMaxArgs = 32;
+// A dex method takes at most 255 argument registers, so this many jvalues.
+static constexpr size_t kMaxMethodArgs = 255;
+
+static JNINativeInterface gJniTraceInterface;
+static std::once_flag g_install_once;
+// Config version the filter and payload capture were last set up for.
+static std::mutex g_apply_lock;
+static uint32_t g_applied_version = 0;  // Guarded by g_apply_lock.
+// Set once before the table is installed.
+static bool g_profiling = false;
+
+#define MIKROM_CALLER_PC() reinterpret_cast<uintptr_t>(__builtin_return_address(0))
+
+struct ScopedVaEnd {
+  explicit ScopedVaEnd(va_list* args) : args(args) {}
+  ~ScopedVaEnd() { va_end(*args); }
+  va_list* args;
+};
+
+// The table the traced call is forwarded to: CheckJNI for debuggable apps.
+static const JNINativeInterface* Next(JNIEnv* env) {
+  return down_cast<JNIEnvExt*>(env)->IsCheckJniEnabled() ? GetCheckJniNativeInterface()
+                                                         : GetJniNativeInterface();
+}
+
+// One call through the tracing table. Calls rejected by JniFilter are only
+// forwarded. Otherwise, in log mode the Trace* helpers below write the call out;
+// in profile mode they do nothing and the forwarded call is timed until the
+// JniCall goes out of scope.
+class JniCall {
+ public:
+  JniCall(JNIEnv* env, const char* function, uintptr_t caller_pc)
+      : JniCall(env, function, JniProfile::kNoTarget, nullptr, caller_pc) {}
+  JniCall(JNIEnv* env, const char* function, jmethodID mid, uintptr_t caller_pc)
+      : JniCall(env, function, JniProfile::kMethodTarget, mid, caller_pc) {}
+  JniCall(JNIEnv* env, const char* function, jfieldID fid, uintptr_t caller_pc)
+      : JniCall(env, function, JniProfile::kFieldTarget, fid, caller_pc) {}
+
+  ~JniCall() {
+    if (traced_ && g_profiling) {
+      JniProfile::Record(env_, function_, kind_, target_, caller_pc_, NanoTime() - start_ns_);
+    }
+  }
+
+  bool Traced() const { return traced_; }
+  bool Logging() const { return traced_ && !g_profiling; }
+  const char* Function() const { return function_; }
+  const void* Target() const { return target_; }
+  uintptr_t CallerPc() const { return caller_pc_; }
+
+ private:
+  JniCall(JNIEnv* env,
+          const char* function,
+          JniProfile::TargetKind kind,
+          const void* target,
+          uintptr_t caller_pc)
+      : env_(env),
+        function_(function),
+        kind_(kind),
+        target_(target),
+        caller_pc_(caller_pc),
+        traced_(JniFilter::Accept(env, caller_pc, kind, target)),
+        start_ns_(traced_ && g_profiling ? NanoTime() : 0) {}
+
+  JNIEnv* const env_;
+  const char* const function_;
+  const JniProfile::TargetKind kind_;
+  const void* const target_;
+  const uintptr_t caller_pc_;
+  const bool traced_;
+  const uint64_t start_ns_;
+
+  DISALLOW_COPY_AND_ASSIGN(JniCall);
+};
+
+static JniArg MakeArg(JniArgType type, uint64_t value) {
+  JniArg arg;
+  memset(&arg, 0, sizeof(arg));
+  arg.type = type;
+  arg.value = value;
+  return arg;
+}
+
+static JniArg MakeIntArg(jint value) {
+  return MakeArg(kJniArgInt, static_cast<uint64_t>(static_cast<int64_t>(value)));
+}
+
+static JniArg MakeStringArg(const char* utf) {
+  return MakeArg(kJniArgString, JniStrings::Contents(utf, strlen(utf)));
+}
+
+static JniArg CaptureObject(const ScopedObjectAccess& soa, jobject obj)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  ObjPtr<mirror::Object> object = soa.Decode<mirror::Object>(obj);
+  if (object == nullptr) {
+    return MakeArg(kJniArgNull, 0);
+  }
+  if (object->IsString()) {
+    return MakeArg(kJniArgString, JniStrings::String(object->AsString()));
+  }
+  return MakeArg(kJniArgObject, static_cast<uint32_t>(object->IdentityHashCode()));
+}
+
+static void EmitCall(const JniCall& call, uint32_t target_id, const JniArg* args, size_t arg_count) {
+  JniCallRecord record;
+  record.header.type = kRecordJniCall;
+  record.header.size = sizeof(record) + arg_count * sizeof(JniArg);
+  record.function_id = JniStrings::Name(call.Function());
+  record.target_id = target_id;
+  record.arg_count = static_cast<uint32_t>(arg_count);
+  record.target = reinterpret_cast<uintptr_t>(call.Target());
+  const ModuleMap::Module* module = ModuleMap::Find(call.CallerPc());
+  if (module != nullptr) {
+    record.caller_module = JniStrings::Module(module);
+    record.caller_pc = call.CallerPc() - module->bias;
+  } else {
+    record.caller_module = 0;
+    record.caller_pc = call.CallerPc();
+  }
+  TraceBuffer::Append(&record, sizeof(record), args, arg_count * sizeof(JniArg));
+}
+
+static const char* GetShorty(ArtMethod* method, uint32_t* shorty_len)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  return method->GetInterfaceMethodIfProxy(kRuntimePointerSize)->GetShorty(shorty_len);
+}
+
+// Records the arguments in |values|, typed by |shorty|.
+static void CaptureJValues(const ScopedObjectAccess& soa,
+                           const JniCall& call,
+                           ArtMethod* method,
+                           const char* shorty,
+                           uint32_t shorty_len,
+                           const jvalue* values) REQUIRES_SHARED(Locks::mutator_lock_) {
+  JniArg captured[kMaxArgs];
+  size_t count = 0;
+  for (size_t i = 1; i < shorty_len && count < kMaxArgs; ++i) {
+    const jvalue& value = values[i - 1];
+    switch (shorty[i]) {
+      case 'Z':
+        captured[count++] = MakeIntArg(value.z);
+        break;
+      case 'B':
+        captured[count++] = MakeIntArg(value.b);
+        break;
+      case 'C':
+        captured[count++] = MakeIntArg(value.c);
+        break;
+      case 'S':
+        captured[count++] = MakeIntArg(value.s);
+        break;
+      case 'I':
+        captured[count++] = MakeIntArg(value.i);
+        break;
+      case 'F':
+        captured[count++] =
+            MakeArg(kJniArgDouble, bit_cast<uint64_t>(static_cast<double>(value.f)));
+        break;
+      case 'D':
+        captured[count++] = MakeArg(kJniArgDouble, bit_cast<uint64_t>(value.d));
+        break;
+      case 'J':
+        captured[count++] = MakeArg(kJniArgLong, static_cast<uint64_t>(value.j));
+        break;
+      case 'L':
+        captured[count++] = CaptureObject(soa, value.l);
+        break;
+    }
+  }
+  EmitCall(call, JniStrings::Method(method), captured, count);
+}
+
+// Decodes |args| into |values| and records them. The caller then makes the call
+// through the A variant with |values|, so each argument is read once and the
+// invocation sees exactly what was logged. Returns false, leaving |args| alone,
+// when the call is not logged.
+static bool TraceVarArgs(JNIEnv* env,
+                         const JniCall& call,
+                         jmethodID mid,
+                         va_list args,
+                         jvalue (&values)[kMaxMethodArgs]) {
+  if (!call.Logging() || mid == nullptr) {
+    return false;
+  }
+  ScopedObjectAccess soa(env);
+  ArtMethod* method = jni::DecodeArtMethod(mid);
+  uint32_t shorty_len = 0;
+  const char* shorty = GetShorty(method, &shorty_len);
+  va_list ap;
+  va_copy(ap, args);
+  for (size_t i = 1; i < shorty_len && i <= kMaxMethodArgs; ++i) {
+    jvalue& value = values[i - 1];
+    switch (shorty[i]) {
+      case 'Z':
+        value.z = static_cast<jboolean>(va_arg(ap, jint));
+        break;
+      case 'B':
+        value.b = static_cast<jbyte>(va_arg(ap, jint));
+        break;
+      case 'C':
+        value.c = static_cast<jchar>(va_arg(ap, jint));
+        break;
+      case 'S':
+        value.s = static_cast<jshort>(va_arg(ap, jint));
+        break;
+      case 'I':
+        value.i = va_arg(ap, jint);
+        break;
+      case 'F':
+        value.f = static_cast<jfloat>(va_arg(ap, jdouble));
+        break;
+      case 'D':
+        value.d = va_arg(ap, jdouble);
+        break;
+      case 'J':
+        value.j = va_arg(ap, jlong);
+        break;
+      case 'L':
+        value.l = va_arg(ap, jobject);
+        break;
+    }
+  }
+  va_end(ap);
+  CaptureJValues(soa, call, method, shorty, shorty_len, values);
+  return true;
+}
+
+static void TraceJValues(JNIEnv* env, const JniCall& call, jmethodID mid, const jvalue* args) {
+  if (!call.Logging() || mid == nullptr) {
+    return;
+  }
+  ScopedObjectAccess soa(env);
+  ArtMethod* method = jni::DecodeArtMethod(mid);
+  uint32_t shorty_len = 0;
+  const char* shorty = GetShorty(method, &shorty_len);
+  CaptureJValues(soa, call, method, shorty, shorty_len, args);
+}
+
+static void TraceField(JNIEnv* env, const JniCall& call, jfieldID fid) {
+  if (!call.Logging() || fid == nullptr) {
+    return;
+  }
+  ScopedObjectAccess soa(env);
+  EmitCall(call, JniStrings::Field(jni::DecodeArtField(fid)), nullptr, 0);
+}
+
+// Records the C strings passed to or returned by a JNI function; null ones are left out.
+static void TraceStr(const JniCall& call, const char* str1, const char* str2) {
+  if (!call.Logging()) {
+    return;
+  }
+  JniArg captured[2];
+  size_t count = 0;
+  if (str1 != nullptr) {
+    captured[count++] = MakeStringArg(str1);
+  }
+  if (str2 != nullptr) {
+    captured[count++] = MakeStringArg(str2);
+  }
+  EmitCall(call, 0, captured, count);
+}
+
+static void TraceString(JNIEnv* env, const JniCall& call, jstring java_string) {
+  if (!call.Logging()) {
+    return;
+  }
+  if (java_string == nullptr) {
+    EmitCall(call, 0, nullptr, 0);
+    return;
+  }
+  ScopedObjectAccess soa(env);
+  JniArg captured = CaptureObject(soa, java_string);
+  EmitCall(call, 0, &captured, 1);
+}
+
+// Records the size of the byte array region passed to a JNI function.
+static void TraceSize(const JniCall& call, jsize size) {
+  if (!call.Logging()) {
+    return;
+  }
+  JniArg captured = MakeIntArg(size);
+  EmitCall(call, 0, &captured, 1);
+}
+
+static bool CapturingData(const JniCall& call) {
+  return call.Traced() && JniData::Enabled();
+}
+
+static void CaptureData(const JniCall& call, const void* data, jsize size) {
+  if (CapturingData(call) && data != nullptr && size >= 0) {
+    JniData::Capture(call.Function(), call.CallerPc(), data, static_cast<size_t>(size));
+  }
+}
+
+static void CaptureUtf(const JniCall& call, const char* utf) {
+  if (CapturingData(call) && utf != nullptr) {
+    JniData::Capture(call.Function(), call.CallerPc(), utf, strlen(utf));
+  }
+}
+
+#define JNI_TRACE_CALL_TYPES(V) \
+  V(jobject, Object)            \
+  V(jboolean, Boolean)          \
+  V(jbyte, Byte)                \
+  V(jchar, Char)                \
+  V(jshort, Short)              \
+  V(jint, Int)                  \
+  V(jlong, Long)                \
+  V(jfloat, Float)              \
+  V(jdouble, Double)            \
+  V(void, Void)
+
+#define JNI_TRACE_FIELD_TYPES(V) \
+  V(jobject, Object)             \
+  V(jboolean, Boolean)           \
+  V(jbyte, Byte)                 \
+  V(jchar, Char)                 \
+  V(jshort, Short)               \
+  V(jint, Int)                   \
+  V(jlong, Long)                 \
+  V(jfloat, Float)               \
+  V(jdouble, Double)
+
+#define DEFINE_TRACE_CALLS(jtype, Type)                                                        \
+  static jtype Call##Type##Method(JNIEnv* env, jobject obj, jmethodID mid, ...) {              \
+    va_list ap;                                                                                \
+    va_start(ap, mid);                                                                         \
+    ScopedVaEnd end_args_later(&ap);                                                           \
+    JniCall call(env, "Call" #Type "Method", mid, MIKROM_CALLER_PC());                         \
+    jvalue values[kMaxMethodArgs];                                                             \
+    if (TraceVarArgs(env, call, mid, ap, values)) {                                            \
+      return Next(env)->Call##Type##MethodA(env, obj, mid, values);                            \
+    }                                                                                          \
+    return Next(env)->Call##Type##MethodV(env, obj, mid, ap);                                  \
+  }                                                                                            \
+  static jtype Call##Type##MethodV(JNIEnv* env, jobject obj, jmethodID mid, va_list args) {    \
+    JniCall call(env, "Call" #Type "MethodV", mid, MIKROM_CALLER_PC());                        \
+    jvalue values[kMaxMethodArgs];                                                             \
+    if (TraceVarArgs(env, call, mid, args, values)) {                                          \
+      return Next(env)->Call##Type##MethodA(env, obj, mid, values);                            \
+    }                                                                                          \
+    return Next(env)->Call##Type##MethodV(env, obj, mid, args);                                \
+  }                                                                                            \
+  static jtype Call##Type##MethodA(JNIEnv* env, jobject obj,                                   \
+                                   jmethodID mid, const jvalue* args) {                        \
+    JniCall call(env, "Call" #Type "MethodA", mid, MIKROM_CALLER_PC());                        \
+    TraceJValues(env, call, mid, args);                                                        \
+    return Next(env)->Call##Type##MethodA(env, obj, mid, args);                                \
+  }                                                                                            \
+  static jtype CallNonvirtual##Type##Method(JNIEnv* env, jobject obj, jclass c,                \
+                                            jmethodID mid, ...) {                              \
+    va_list ap;                                                                                \
+    va_start(ap, mid);                                                                         \
+    ScopedVaEnd end_args_later(&ap);                                                           \
+    JniCall call(env, "CallNonvirtual" #Type "Method", mid, MIKROM_CALLER_PC());               \
+    jvalue values[kMaxMethodArgs];                                                             \
+    if (TraceVarArgs(env, call, mid, ap, values)) {                                            \
+      return Next(env)->CallNonvirtual##Type##MethodA(env, obj, c, mid, values);               \
+    }                                                                                          \
+    return Next(env)->CallNonvirtual##Type##MethodV(env, obj, c, mid, ap);                     \
+  }                                                                                            \
+  static jtype CallNonvirtual##Type##MethodV(JNIEnv* env, jobject obj, jclass c,               \
+                                             jmethodID mid, va_list args) {                    \
+    JniCall call(env, "CallNonvirtual" #Type "MethodV", mid, MIKROM_CALLER_PC());              \
+    jvalue values[kMaxMethodArgs];                                                             \
+    if (TraceVarArgs(env, call, mid, args, values)) {                                          \
+      return Next(env)->CallNonvirtual##Type##MethodA(env, obj, c, mid, values);               \
+    }                                                                                          \
+    return Next(env)->CallNonvirtual##Type##MethodV(env, obj, c, mid, args);                   \
+  }                                                                                            \
+  static jtype CallNonvirtual##Type##MethodA(JNIEnv* env, jobject obj, jclass c,               \
+                                             jmethodID mid, const jvalue* args) {              \
+    JniCall call(env, "CallNonvirtual" #Type "MethodA", mid, MIKROM_CALLER_PC());              \
+    TraceJValues(env, call, mid, args);                                                        \
+    return Next(env)->CallNonvirtual##Type##MethodA(env, obj, c, mid, args);                   \
+  }                                                                                            \
+  static jtype CallStatic##Type##Method(JNIEnv* env, jclass c, jmethodID mid, ...) {           \
+    va_list ap;                                                                                \
+    va_start(ap, mid);                                                                         \
+    ScopedVaEnd end_args_later(&ap);                                                           \
+    JniCall call(env, "CallStatic" #Type "Method", mid, MIKROM_CALLER_PC());                   \
+    jvalue values[kMaxMethodArgs];                                                             \
+    if (TraceVarArgs(env, call, mid, ap, values)) {                                            \
+      return Next(env)->CallStatic##Type##MethodA(env, c, mid, values);                        \
+    }                                                                                          \
+    return Next(env)->CallStatic##Type##MethodV(env, c, mid, ap);                              \
+  }                                                                                            \
+  static jtype CallStatic##Type##MethodV(JNIEnv* env, jclass c, jmethodID mid, va_list args) { \
+    JniCall call(env, "CallStatic" #Type "MethodV", mid, MIKROM_CALLER_PC());                  \
+    jvalue values[kMaxMethodArgs];                                                             \
+    if (TraceVarArgs(env, call, mid, args, values)) {                                          \
+      return Next(env)->CallStatic##Type##MethodA(env, c, mid, values);                        \
+    }                                                                                          \
+    return Next(env)->CallStatic##Type##MethodV(env, c, mid, args);                            \
+  }                                                                                            \
+  static jtype CallStatic##Type##MethodA(JNIEnv* env, jclass c,                                \
+                                         jmethodID mid, const jvalue* args) {                  \
+    JniCall call(env, "CallStatic" #Type "MethodA", mid, MIKROM_CALLER_PC());                  \
+    TraceJValues(env, call, mid, args);                                                        \
+    return Next(env)->CallStatic##Type##MethodA(env, c, mid, args);                            \
+  }
+
+#define DEFINE_TRACE_FIELDS(jtype, Type)                                                       \
+  static jtype Get##Type##Field(JNIEnv* env, jobject obj, jfieldID fid) {                      \
+    JniCall call(env, "Get" #Type "Field", fid, MIKROM_CALLER_PC());                           \
+    TraceField(env, call, fid);                                                                \
+    return Next(env)->Get##Type##Field(env, obj, fid);                                         \
+  }                                                                                            \
+  static jtype GetStatic##Type##Field(JNIEnv* env, jclass c, jfieldID fid) {                   \
+    JniCall call(env, "GetStatic" #Type "Field", fid, MIKROM_CALLER_PC());                     \
+    TraceField(env, call, fid);                                                                \
+    return Next(env)->GetStatic##Type##Field(env, c, fid);                                     \
+  }                                                                                            \
+  static void Set##Type##Field(JNIEnv* env, jobject obj, jfieldID fid, jtype value) {          \
+    JniCall call(env, "Set" #Type "Field", fid, MIKROM_CALLER_PC());                           \
+    TraceField(env, call, fid);                                                                \
+    Next(env)->Set##Type##Field(env, obj, fid, value);                                         \
+  }                                                                                            \
+  static void SetStatic##Type##Field(JNIEnv* env, jclass c, jfieldID fid, jtype value) {       \
+    JniCall call(env, "SetStatic" #Type "Field", fid, MIKROM_CALLER_PC());                     \
+    TraceField(env, call, fid);                                                                \
+    Next(env)->SetStatic##Type##Field(env, c, fid, value);                                     \
+  }
+
+JNI_TRACE_CALL_TYPES(DEFINE_TRACE_CALLS)
+JNI_TRACE_FIELD_TYPES(DEFINE_TRACE_FIELDS)
+
+#undef DEFINE_TRACE_CALLS
+#undef DEFINE_TRACE_FIELDS
+
+static jclass FindClass(JNIEnv* env, const char* name) {
+  JniCall call(env, "FindClass", MIKROM_CALLER_PC());
+  TraceStr(call, name, nullptr);
+  return Next(env)->FindClass(env, name);
+}
+
+static jmethodID GetMethodID(JNIEnv* env, jclass c, const char* name, const char* sig) {
+  JniCall call(env, "GetMethodID", MIKROM_CALLER_PC());
+  TraceStr(call, name, sig);
+  return Next(env)->GetMethodID(env, c, name, sig);
+}
+
+static jmethodID GetStaticMethodID(JNIEnv* env, jclass c, const char* name, const char* sig) {
+  JniCall call(env, "GetStaticMethodID", MIKROM_CALLER_PC());
+  TraceStr(call, name, sig);
+  return Next(env)->GetStaticMethodID(env, c, name, sig);
+}
+
+static jfieldID GetFieldID(JNIEnv* env, jclass c, const char* name, const char* sig) {
+  JniCall call(env, "GetFieldID", MIKROM_CALLER_PC());
+  TraceStr(call, name, sig);
+  return Next(env)->GetFieldID(env, c, name, sig);
+}
+
+static jfieldID GetStaticFieldID(JNIEnv* env, jclass c, const char* name, const char* sig) {
+  JniCall call(env, "GetStaticFieldID", MIKROM_CALLER_PC());
+  jfieldID result = Next(env)->GetStaticFieldID(env, c, name, sig);
+  TraceStr(call, name, sig);
+  return result;
+}
+
+static jstring NewString(JNIEnv* env, const jchar* chars, jsize char_count) {
+  JniCall call(env, "NewString", MIKROM_CALLER_PC());
+  jstring result = Next(env)->NewString(env, chars, char_count);
+  TraceString(env, call, result);
+  return result;
+}
+
+static jstring NewStringUTF(JNIEnv* env, const char* utf) {
+  JniCall call(env, "NewStringUTF", MIKROM_CALLER_PC());
+  TraceStr(call, utf, nullptr);
+  CaptureUtf(call, utf);
+  return Next(env)->NewStringUTF(env, utf);
+}
+
+static jsize GetStringLength(JNIEnv* env, jstring java_string) {
+  JniCall call(env, "GetStringLength", MIKROM_CALLER_PC());
+  TraceString(env, call, java_string);
+  return Next(env)->GetStringLength(env, java_string);
+}
+
+static const jchar* GetStringChars(JNIEnv* env, jstring java_string, jboolean* is_copy) {
+  JniCall call(env, "GetStringChars", MIKROM_CALLER_PC());
+  TraceString(env, call, java_string);
+  return Next(env)->GetStringChars(env, java_string, is_copy);
+}
+
+static void ReleaseStringChars(JNIEnv* env, jstring java_string, const jchar* chars) {
+  JniCall call(env, "ReleaseStringChars", MIKROM_CALLER_PC());
+  TraceString(env, call, java_string);
+  Next(env)->ReleaseStringChars(env, java_string, chars);
+}
+
+static const char* GetStringUTFChars(JNIEnv* env, jstring java_string, jboolean* is_copy) {
+  JniCall call(env, "GetStringUTFChars", MIKROM_CALLER_PC());
+  const char* result = Next(env)->GetStringUTFChars(env, java_string, is_copy);
+  TraceStr(call, result, nullptr);
+  CaptureUtf(call, result);
+  return result;
+}
+
+static jsize GetArrayLength(JNIEnv* env, jarray array) {
+  JniCall call(env, "GetArrayLength", MIKROM_CALLER_PC());
+  TraceStr(call, nullptr, nullptr);
+  return Next(env)->GetArrayLength(env, array);
+}
+
+static jobject GetObjectArrayElement(JNIEnv* env, jobjectArray array, jsize index) {
+  JniCall call(env, "GetObjectArrayElement", MIKROM_CALLER_PC());
+  TraceStr(call, nullptr, nullptr);
+  return Next(env)->GetObjectArrayElement(env, array, index);
+}
+
+static void SetObjectArrayElement(JNIEnv* env, jobjectArray array, jsize index, jobject value) {
+  JniCall call(env, "SetObjectArrayElement", MIKROM_CALLER_PC());
+  TraceStr(call, nullptr, nullptr);
+  Next(env)->SetObjectArrayElement(env, array, index, value);
+}
+
+static jbyte* GetByteArrayElements(JNIEnv* env, jbyteArray array, jboolean* is_copy) {
+  JniCall call(env, "GetByteArrayElements", MIKROM_CALLER_PC());
+  jbyte* result = Next(env)->GetByteArrayElements(env, array, is_copy);
+  if (result != nullptr && (call.Logging() || CapturingData(call))) {
+    jsize length = Next(env)->GetArrayLength(env, array);
+    TraceSize(call, length);
+    CaptureData(call, result, length);
+  }
+  return result;
+}
+
+static void SetByteArrayRegion(JNIEnv* env,
+                               jbyteArray array,
+                               jsize start,
+                               jsize length,
+                               const jbyte* buf) {
+  JniCall call(env, "SetByteArrayRegion", MIKROM_CALLER_PC());
+  TraceSize(call, length);
+  CaptureData(call, buf, length);
+  Next(env)->SetByteArrayRegion(env, array, start, length, buf);
+}
+
+static void InstallWrappers(JNINativeInterface* table) {
+#define INSTALL_TRACE_CALLS(jtype, Type)                                   \
+  table->Call##Type##Method = Call##Type##Method;                          \
+  table->Call##Type##MethodV = Call##Type##MethodV;                        \
+  table->Call##Type##MethodA = Call##Type##MethodA;                        \
+  table->CallNonvirtual##Type##Method = CallNonvirtual##Type##Method;      \
+  table->CallNonvirtual##Type##MethodV = CallNonvirtual##Type##MethodV;    \
+  table->CallNonvirtual##Type##MethodA = CallNonvirtual##Type##MethodA;    \
+  table->CallStatic##Type##Method = CallStatic##Type##Method;              \
+  table->CallStatic##Type##MethodV = CallStatic##Type##MethodV;            \
+  table->CallStatic##Type##MethodA = CallStatic##Type##MethodA;
+#define INSTALL_TRACE_FIELDS(jtype, Type)                                  \
+  table->Get##Type##Field = Get##Type##Field;                              \
+  table->GetStatic##Type##Field = GetStatic##Type##Field;                  \
+  table->Set##Type##Field = Set##Type##Field;                              \
+  table->SetStatic##Type##Field = SetStatic##Type##Field;
+  JNI_TRACE_CALL_TYPES(INSTALL_TRACE_CALLS)
+  JNI_TRACE_FIELD_TYPES(INSTALL_TRACE_FIELDS)
+#undef INSTALL_TRACE_CALLS
+#undef INSTALL_TRACE_FIELDS
+  table->FindClass = FindClass;
+  table->GetMethodID = GetMethodID;
+  table->GetStaticMethodID = GetStaticMethodID;
+  table->GetFieldID = GetFieldID;
+  table->GetStaticFieldID = GetStaticFieldID;
+  table->NewString = NewString;
+  table->NewStringUTF = NewStringUTF;
+  table->GetStringLength = GetStringLength;
+  table->GetStringChars = GetStringChars;
+  table->ReleaseStringChars = ReleaseStringChars;
+  table->GetStringUTFChars = GetStringUTFChars;
+  table->GetArrayLength = GetArrayLength;
+  table->GetObjectArrayElement = GetObjectArrayElement;
+  table->SetObjectArrayElement = SetObjectArrayElement;
+  table->GetByteArrayElements = GetByteArrayElements;
+  table->SetByteArrayRegion = SetByteArrayRegion;
+}
+
+}  // namespace
+
+void JniTrace::Start(Thread* self) {
+  int mode;
+  uint32_t version;
+  std::string libs;
+  std::string methods;
+  int data_max_bytes;
+  int data_sample_rate;
+  {
+    ScopedObjectAccess soa(self);
+    const PackageConfig& config = PackageConfig::Current();
+    if (!config.is_jni_method_print) {
+      return;
+    }
+    mode = config.jni_trace_mode;
+    version = config.version;
+    libs = config.jni_trace_libs;
+    methods = config.jni_trace_methods;
+    data_max_bytes = config.jni_data_max_bytes;
+    data_sample_rate = config.jni_data_sample_rate;
+  }
+  {
+    // Rebuilt for every config version, published ones start at 1; a load
+    // racing with a newer one is ignored.
+    std::lock_guard<std::mutex> guard(g_apply_lock);
+    if (version > g_applied_version) {
+      g_applied_version = version;
+      JniFilter::Init(libs, methods);
+      JniData::Init(data_max_bytes, data_sample_rate);
+    }
+  }
+  // The wrappers and jniTraceMode are installed once.
+  std::call_once(g_install_once, [&] {
+    g_profiling = mode == kJniTraceProfile;
+    gJniTraceInterface = *GetJniNativeInterface();
+    InstallWrappers(&gJniTraceInterface);
+    // Resets the table of every attached thread; threads attached later pick
+    // the override up in JNIEnvExt::GetFunctionTable().
+    JNIEnvExt::SetTableOverride(&gJniTraceInterface);
+    LOG(ERROR) << "mikrom jni trace table installed, decode with mikromtrace "
+               << (g_profiling ? "jniprofile" : "jni");
+  });
+}
+
+}  // namespace mikrom
+}  // namespace art
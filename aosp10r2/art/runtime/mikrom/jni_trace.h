@@ -0,0 +1,35 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_JNI_TRACE_H_
+#define ART_RUNTIME_MIKROM_JNI_TRACE_H_
+
+#include "base/locks.h"
+
+namespace art {
+
+class Thread;
+
+namespace mikrom {
+
+// isJNIMethodPrint support. The tracing wrappers live in their own
+// JNINativeInterface, installed over every JNIEnv (the way CheckJNI swaps its
+// table) only when the config enables JNI tracing, so jni_internal.cc keeps the
+// stock code paths and other processes pay nothing. Calls are written to the
+// binary trace as JniCallRecords (mikrom/trace_format.h), or counted by
+// JniProfile in profile mode; JniData optionally captures string and byte array
+// payloads into a side file.
+enum JniTraceMode {
+  kJniTraceLog = 0,
+  kJniTraceProfile = 1,
+};
+
+class JniTrace {
+ public:
+  // Installs the tracing table if the current config asks for it. Called after
+  // the config is set, |self| must not hold the mutator lock.
+  static void Start(Thread* self) REQUIRES(!Locks::mutator_lock_);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_JNI_TRACE_H_
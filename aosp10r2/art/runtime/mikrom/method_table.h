@@ -0,0 +1,255 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_METHOD_TABLE_H_
+#define ART_RUNTIME_MIKROM_METHOD_TABLE_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace art {
+namespace mikrom {
+
+// Open addressing map from a pointer (usually an ArtMethod*) to a 32-bit value.
+// Lookups are lock free and meant for hot paths; inserts take a lock and are
+// expected once per key. Entries are never removed, only their value replaced.
+// The table starts with 2^capacity_log2 slots and doubles up to
+// 2^max_capacity_log2 when it is 3/4 full; a replaced array stays allocated
+// until the table is destroyed, since lookups may still be reading it.
+class PointerTable {
+ public:
+  explicit PointerTable(size_t capacity_log2)
+      : PointerTable(capacity_log2, capacity_log2) {}
+  PointerTable(size_t capacity_log2, size_t max_capacity_log2)
+      : initial_mask_((1u << capacity_log2) - 1),
+        max_mask_((1u << max_capacity_log2) - 1) {}
+
+  ~PointerTable() {
+    free(table_.load(std::memory_order_relaxed));
+    for (Table* retired : retired_) {
+      free(retired);
+    }
+  }
+
+  bool Lookup(const void* key, uint32_t* value) const {
+    Table* table = table_.load(std::memory_order_acquire);
+    if (table == nullptr) {
+      return false;
+    }
+    uintptr_t k = reinterpret_cast<uintptr_t>(key);
+    const size_t mask = table->mask;
+    for (size_t i = Hash(k, mask), probes = 0; probes <= mask; i = (i + 1) & mask, ++probes) {
+      uintptr_t current = table->entries[i].key.load(std::memory_order_acquire);
+      if (current == k) {
+        *value = table->entries[i].value.load(std::memory_order_relaxed);
+        return true;
+      }
+      if (current == 0) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  // Associates *|value| with |key| unless the key is already present, in which
+  // case *|value| is set to the existing value. Returns false if the table is full.
+  bool Insert(const void* key, uint32_t* value) {
+    std::lock_guard<std::mutex> guard(lock_);
+    return InsertLocked(reinterpret_cast<uintptr_t>(key), value, /* replace= */ false);
+  }
+
+  // Associates |value| with |key|, replacing the value of an existing key.
+  // Returns false if the table is full.
+  bool Set(const void* key, uint32_t value) {
+    std::lock_guard<std::mutex> guard(lock_);
+    return InsertLocked(reinterpret_cast<uintptr_t>(key), &value, /* replace= */ true);
+  }
+
+  // Calls |visitor(key, value)| for every entry. Concurrent inserts may or may not be seen.
+  template <typename Visitor>
+  void VisitAll(const Visitor& visitor) const {
+    Table* table = table_.load(std::memory_order_acquire);
+    if (table == nullptr) {
+      return;
+    }
+    for (size_t i = 0; i <= table->mask; ++i) {
+      uintptr_t k = table->entries[i].key.load(std::memory_order_acquire);
+      if (k != 0) {
+        visitor(reinterpret_cast<const void*>(k),
+                table->entries[i].value.load(std::memory_order_relaxed));
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    std::atomic<uintptr_t> key;
+    std::atomic<uint32_t> value;
+  };
+
+  // Allocated in one block, |entries| points right behind the header.
+  struct Table {
+    size_t mask;
+    Entry* entries;
+  };
+
+  bool InsertLocked(uintptr_t k, uint32_t* value, bool replace) {
+    Table* table = table_.load(std::memory_order_relaxed);
+    if (table == nullptr) {
+      table = Allocate(initial_mask_);
+      if (table == nullptr) {
+        return false;
+      }
+      table_.store(table, std::memory_order_release);
+    }
+    Entry* slot = Find(table, k);
+    if (slot != nullptr && slot->key.load(std::memory_order_relaxed) == k) {
+      if (replace) {
+        slot->value.store(*value, std::memory_order_relaxed);
+      } else {
+        *value = slot->value.load(std::memory_order_relaxed);
+      }
+      return true;
+    }
+    if (size_ * 4 >= (table->mask + 1) * 3) {
+      table = Grow(table);
+      if (table == nullptr) {
+        return false;
+      }
+      slot = Find(table, k);
+    }
+    if (slot == nullptr) {
+      return false;
+    }
+    slot->value.store(*value, std::memory_order_relaxed);
+    slot->key.store(k, std::memory_order_release);
+    ++size_;
+    return true;
+  }
+
+  static size_t Hash(uintptr_t k, size_t mask) {
+    // ArtMethods are at least 4-byte aligned; fold the high bits in.
+    uint64_t h = static_cast<uint64_t>(k) * UINT64_C(0x9E3779B97F4A7C15);
+    return static_cast<size_t>(h >> 32) & mask;
+  }
+
+  static Table* Allocate(size_t mask) {
+    Table* table = static_cast<Table*>(calloc(1, sizeof(Table) + (mask + 1) * sizeof(Entry)));
+    if (table != nullptr) {
+      table->mask = mask;
+      table->entries = reinterpret_cast<Entry*>(table + 1);
+    }
+    return table;
+  }
+
+  // The slot holding |k|, or the free slot it would go to, or null if neither exists.
+  static Entry* Find(Table* table, uintptr_t k) {
+    const size_t mask = table->mask;
+    for (size_t i = Hash(k, mask), probes = 0; probes <= mask; i = (i + 1) & mask, ++probes) {
+      uintptr_t current = table->entries[i].key.load(std::memory_order_relaxed);
+      if (current == k || current == 0) {
+        return &table->entries[i];
+      }
+    }
+    return nullptr;
+  }
+
+  // Publishes a table of twice the size, or returns null at max capacity.
+  Table* Grow(Table* table) {
+    if (table->mask >= max_mask_) {
+      return nullptr;
+    }
+    Table* grown = Allocate(table->mask * 2 + 1);
+    if (grown == nullptr) {
+      return nullptr;
+    }
+    for (size_t i = 0; i <= table->mask; ++i) {
+      uintptr_t k = table->entries[i].key.load(std::memory_order_relaxed);
+      if (k != 0) {
+        Entry* slot = Find(grown, k);
+        slot->value.store(table->entries[i].value.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+        slot->key.store(k, std::memory_order_relaxed);
+      }
+    }
+    table_.store(grown, std::memory_order_release);
+    retired_.push_back(table);
+    return grown;
+  }
+
+  const size_t initial_mask_;
+  const size_t max_mask_;
+  std::atomic<Table*> table_{nullptr};
+  std::mutex lock_;
+  size_t size_ = 0;
+  std::vector<Table*> retired_;  // Guarded by lock_.
+};
+
+// Maps the small dense ids handed out by SmaliTrace to per-method state. Lookups
+// are a lock free array load; the array is allocated on the first Set().
+template <typename T>
+class IdTable {
+ public:
+  static constexpr uint32_t kMaxIds = 1u << 16;
+
+  T* Get(uint32_t id) const {
+    std::atomic<T*>* slots = slots_.load(std::memory_order_acquire);
+    if (slots == nullptr || id >= kMaxIds) {
+      return nullptr;
+    }
+    return slots[id].load(std::memory_order_acquire);
+  }
+
+  // Stores |value| for |id| unless it already has one. Returns false if |value|
+  // was not taken, in which case the caller keeps ownership.
+  bool Set(uint32_t id, T* value) {
+    if (id >= kMaxIds) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard(lock_);
+    std::atomic<T*>* slots = slots_.load(std::memory_order_relaxed);
+    if (slots == nullptr) {
+      slots = static_cast<std::atomic<T*>*>(calloc(kMaxIds, sizeof(std::atomic<T*>)));
+      if (slots == nullptr) {
+        return false;
+      }
+      slots_.store(slots, std::memory_order_release);
+    }
+    if (slots[id].load(std::memory_order_relaxed) != nullptr) {
+      return false;
+    }
+    slots[id].store(value, std::memory_order_release);
+    if (id > max_id_.load(std::memory_order_relaxed)) {
+      max_id_.store(id, std::memory_order_release);
+    }
+    return true;
+  }
+
+  // Calls |visitor(id, value)| for every id set so far.
+  template <typename Visitor>
+  void VisitAll(const Visitor& visitor) const {
+    std::atomic<T*>* slots = slots_.load(std::memory_order_acquire);
+    uint32_t max_id = max_id_.load(std::memory_order_acquire);
+    if (slots == nullptr) {
+      return;
+    }
+    for (uint32_t id = 0; id <= max_id; ++id) {
+      T* value = slots[id].load(std::memory_order_acquire);
+      if (value != nullptr) {
+        visitor(id, value);
+      }
+    }
+  }
+
+ private:
+  std::atomic<std::atomic<T*>*> slots_{nullptr};
+  std::atomic<uint32_t> max_id_{0};
+  std::mutex lock_;
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_METHOD_TABLE_H_
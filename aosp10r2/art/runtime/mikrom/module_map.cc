@@ -0,0 +1,142 @@
+// change mikrom
+#include "mikrom/module_map.h"
+
+#include <link.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <android-base/logging.h>
+
+#include "base/bit_utils.h"
+#include "base/globals.h"
+#include "base/macros.h"
+#include "base/memory_type_table.h"
+#include "base/time_utils.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+// The type of a range is the index of its module.
+struct Snapshot {
+  MemoryTypeTable<uint32_t> ranges;
+  std::vector<ModuleMap::Module> modules;
+};
+
+struct SnapshotBuilder {
+  MemoryTypeTable<uint32_t>::Builder ranges;
+  std::vector<ModuleMap::Module> modules;
+};
+
+// Module::name_id by path, guarded by g_refresh_lock.
+static std::unordered_map<std::string, uint32_t> g_name_ids;
+
+// Replaced snapshots are never freed: a reader may still be searching one. They
+// are only replaced when the set of modules changed.
+static std::atomic<const Snapshot*> g_snapshot{nullptr};
+static std::atomic<uint64_t> g_last_refresh_ns{0};
+static std::mutex g_refresh_lock;
+
+static int VisitElfInfo(struct dl_phdr_info* info, size_t size ATTRIBUTE_UNUSED, void* data) {
+  SnapshotBuilder* builder = reinterpret_cast<SnapshotBuilder*>(data);
+  uint32_t index = static_cast<uint32_t>(builder->modules.size());
+  bool has_code = false;
+  for (size_t i = 0u; i < info->dlpi_phnum; ++i) {
+    const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+    if (phdr.p_type != PT_LOAD || ((phdr.p_flags & PF_X) != PF_X)) {
+      continue;  // Only code can be a return address.
+    }
+    uintptr_t start = info->dlpi_addr + phdr.p_vaddr;
+    uintptr_t limit = RoundUp(start + phdr.p_memsz, kPageSize);
+    if (builder->ranges.Add(MemoryTypeRange<uint32_t>(start, limit, index))) {
+      has_code = true;
+    }
+  }
+  if (has_code) {
+    ModuleMap::Module module;
+    module.bias = info->dlpi_addr;
+    module.name = info->dlpi_name != nullptr && info->dlpi_name[0] != '\0'
+        ? info->dlpi_name
+        : "<main>";
+    auto it = g_name_ids.emplace(module.name, static_cast<uint32_t>(g_name_ids.size() + 1)).first;
+    module.name_id = it->second;
+    builder->modules.push_back(std::move(module));
+  }
+  return 0;
+}
+
+static bool SameModules(const Snapshot& snapshot, const SnapshotBuilder& builder) {
+  if (snapshot.modules.size() != builder.modules.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < snapshot.modules.size(); ++i) {
+    if (snapshot.modules[i].bias != builder.modules[i].bias ||
+        snapshot.modules[i].name != builder.modules[i].name) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static const Snapshot* Refresh(bool wait) {
+  std::unique_lock<std::mutex> lock(g_refresh_lock, std::defer_lock);
+  if (wait) {
+    lock.lock();
+  } else if (!lock.try_lock()) {
+    // Another thread is rebuilding, don't wait for it.
+    return g_snapshot.load(std::memory_order_acquire);
+  }
+  const Snapshot* current = g_snapshot.load(std::memory_order_acquire);
+  g_last_refresh_ns.store(NanoTime(), std::memory_order_relaxed);
+  SnapshotBuilder builder;
+  dl_iterate_phdr(VisitElfInfo, &builder);
+  if (current != nullptr && SameModules(*current, builder)) {
+    return current;
+  }
+  Snapshot* snapshot = new Snapshot;
+  snapshot->ranges = builder.ranges.Build();
+  snapshot->modules = std::move(builder.modules);
+  g_snapshot.store(snapshot, std::memory_order_release);
+  return snapshot;
+}
+
+static const ModuleMap::Module* Search(const Snapshot* snapshot, uintptr_t pc) {
+  if (snapshot == nullptr) {
+    return nullptr;
+  }
+  const MemoryTypeRange<uint32_t>* range = snapshot->ranges.Lookup(pc);
+  return range != nullptr ? &snapshot->modules[range->Type()] : nullptr;
+}
+
+}  // namespace
+
+const ModuleMap::Module* ModuleMap::Find(uintptr_t pc) {
+  const Snapshot* snapshot = g_snapshot.load(std::memory_order_acquire);
+  const Module* module = Search(snapshot, pc);
+  if (LIKELY(module != nullptr)) {
+    return module;
+  }
+  // Code outside any module, e.g. unpacked into anonymous memory, keeps missing;
+  // don't rescan for each call.
+  if (snapshot != nullptr &&
+      NanoTime() - g_last_refresh_ns.load(std::memory_order_relaxed) <
+          MsToNs(kRefreshIntervalMs)) {
+    return nullptr;
+  }
+  return Search(Refresh(/* wait= */ false), pc);
+}
+
+const ModuleMap::Module* ModuleMap::FindFresh(uintptr_t pc) {
+  const Module* module = Search(g_snapshot.load(std::memory_order_acquire), pc);
+  if (LIKELY(module != nullptr)) {
+    return module;
+  }
+  return Search(Refresh(/* wait= */ true), pc);
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,43 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_MODULE_MAP_H_
+#define ART_RUNTIME_MIKROM_MODULE_MAP_H_
+
+#include <stdint.h>
+
+#include <string>
+
+namespace art {
+namespace mikrom {
+
+// Executable segments of the loaded ELF modules, to turn a native return address
+// into lib+offset. Like CodeRangeCache in jni_internal.cc the ranges come from
+// dl_iterate_phdr() into a MemoryTypeTable; the table is immutable and published
+// through an atomic pointer, so Find() is a lock free binary search. An address
+// that misses rebuilds the table (at most every kRefreshIntervalMs), which picks
+// up libraries dlopen()ed since the last build.
+class ModuleMap {
+ public:
+  struct Module {
+    uintptr_t bias;    // Load bias: pc - bias is the address in the ELF file.
+    std::string name;  // Path of the module.
+    // Non-zero and the same for every Module with this name, across rebuilds of
+    // the table and reloads of the library, unlike the Module's address.
+    uint32_t name_id;
+  };
+
+  static constexpr uint64_t kRefreshIntervalMs = 100;
+
+  // Returns the module whose code contains |pc|, or nullptr. The module stays
+  // valid for the lifetime of the process.
+  static const Module* Find(uintptr_t pc);
+
+  // Like Find(), but a miss always rebuilds the table, waiting for a rebuild in
+  // progress. For rare lookups that must see a library dlopen()ed just now, e.g.
+  // natives registered from its JNI_OnLoad.
+  static const Module* FindFresh(uintptr_t pc);
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_MODULE_MAP_H_
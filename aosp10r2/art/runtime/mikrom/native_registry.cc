@@ -0,0 +1,261 @@
+// change mikrom
+#include "mikrom/native_registry.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+
+#include <android-base/logging.h>
+
+#include "art_method-inl.h"
+#include "base/time_utils.h"
+#include "base/utils.h"
+#include "mikrom/module_map.h"
+#include "mikrom/trace_format.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+// How often Snapshot() retries an entry that is being written before skipping it.
+static constexpr int kReadRetries = 100;
+
+struct Entry {
+  std::atomic<uintptr_t> method;  // 0 while free, set once.
+  std::atomic<uint32_t> seq;      // Odd while the fields below are written, 0 before that.
+  std::atomic<const char*> name;  // PrettyMethod(), set once and never freed.
+  std::atomic<uintptr_t> native;  // 0 once unregistered.
+  std::atomic<const ModuleMap::Module*> module;
+  std::atomic<uint64_t> time_ns;
+  std::atomic<uint32_t> tid;
+  std::atomic<uint32_t> registrations;
+};
+
+static std::atomic<Entry*> g_entries{nullptr};
+static std::atomic<bool> g_full_logged{false};
+
+static Entry* Entries() {
+  Entry* entries = g_entries.load(std::memory_order_acquire);
+  if (LIKELY(entries != nullptr)) {
+    return entries;
+  }
+  Entry* fresh = static_cast<Entry*>(calloc(NativeRegistry::kMaxMethods, sizeof(Entry)));
+  if (fresh == nullptr) {
+    return nullptr;
+  }
+  if (!g_entries.compare_exchange_strong(entries, fresh, std::memory_order_acq_rel)) {
+    free(fresh);
+    return entries;
+  }
+  return fresh;
+}
+
+static size_t Hash(uintptr_t key) {
+  uint64_t h = static_cast<uint64_t>(key) * UINT64_C(0x9E3779B97F4A7C15);
+  return static_cast<size_t>(h >> 32) & (NativeRegistry::kMaxMethods - 1);
+}
+
+// Returns the entry of |method|, claiming a free one if |claim|.
+static Entry* Find(ArtMethod* method, bool claim) {
+  Entry* entries = Entries();
+  if (entries == nullptr) {
+    return nullptr;
+  }
+  uintptr_t key = reinterpret_cast<uintptr_t>(method);
+  for (size_t i = Hash(key), probes = 0;
+       probes < NativeRegistry::kMaxMethods;
+       i = (i + 1) & (NativeRegistry::kMaxMethods - 1), ++probes) {
+    uintptr_t current = entries[i].method.load(std::memory_order_acquire);
+    if (current == key) {
+      return &entries[i];
+    }
+    if (current == 0) {
+      if (!claim) {
+        return nullptr;
+      }
+      if (entries[i].method.compare_exchange_strong(current, key, std::memory_order_acq_rel) ||
+          current == key) {
+        return &entries[i];
+      }
+    }
+  }
+  if (!g_full_logged.exchange(true)) {
+    LOG(ERROR) << "mikrom NativeRegistry is full";
+  }
+  return nullptr;
+}
+
+static void BeginWrite(Entry* entry, uint32_t* seq) {
+  uint32_t s = entry->seq.load(std::memory_order_relaxed);
+  while ((s & 1) != 0 ||
+         !entry->seq.compare_exchange_weak(s, s + 1, std::memory_order_acquire)) {
+    s = entry->seq.load(std::memory_order_relaxed);
+  }
+  *seq = s + 1;
+}
+
+static void EndWrite(Entry* entry, uint32_t seq) {
+  entry->seq.store(seq + 1, std::memory_order_release);
+}
+
+static void Update(Entry* entry, const void* native_method, bool registered) {
+  uintptr_t native = reinterpret_cast<uintptr_t>(native_method);
+  // Registration is rare and often comes from the JNI_OnLoad of a library
+  // dlopen()ed just now, which the throttled Find() would miss for good.
+  const ModuleMap::Module* module = registered ? ModuleMap::FindFresh(native) : nullptr;
+  uint32_t seq;
+  BeginWrite(entry, &seq);
+  entry->native.store(native, std::memory_order_relaxed);
+  entry->module.store(module, std::memory_order_relaxed);
+  entry->time_ns.store(NanoTime(), std::memory_order_relaxed);
+  entry->tid.store(static_cast<uint32_t>(GetTid()), std::memory_order_relaxed);
+  if (registered) {
+    entry->registrations.fetch_add(1, std::memory_order_relaxed);
+  }
+  EndWrite(entry, seq);
+}
+
+static void AppendBytes(std::vector<uint8_t>* out, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  out->insert(out->end(), bytes, bytes + size);
+}
+
+static bool WriteFully(int fd, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    ssize_t n = TEMP_FAILURE_RETRY(write(fd, bytes, size));
+    if (n <= 0) {
+      return false;
+    }
+    bytes += n;
+    size -= n;
+  }
+  return true;
+}
+
+}  // namespace
+
+void NativeRegistry::Register(ArtMethod* method, const void* native_method) {
+  Entry* entry = Find(method, /* claim= */ true);
+  if (entry == nullptr) {
+    return;
+  }
+  if (entry->name.load(std::memory_order_acquire) == nullptr) {
+    std::string pretty = method->PrettyMethod();
+    char* name = strdup(pretty.c_str());
+    const char* expected = nullptr;
+    if (name != nullptr &&
+        !entry->name.compare_exchange_strong(expected, name, std::memory_order_acq_rel)) {
+      free(name);
+    }
+  }
+  Update(entry, native_method, /* registered= */ true);
+}
+
+void NativeRegistry::Unregister(ArtMethod* method) {
+  Entry* entry = Find(method, /* claim= */ false);
+  if (entry != nullptr) {
+    Update(entry, nullptr, /* registered= */ false);
+  }
+}
+
+std::vector<uint8_t> NativeRegistry::Snapshot() {
+  std::vector<uint8_t> records;
+  Entry* entries = g_entries.load(std::memory_order_acquire);
+  for (uint32_t i = 0; entries != nullptr && i < kMaxMethods; ++i) {
+    Entry& entry = entries[i];
+    uintptr_t method = entry.method.load(std::memory_order_acquire);
+    if (method == 0) {
+      continue;
+    }
+    NativeRecord record;
+    memset(&record, 0, sizeof(record));
+    uintptr_t native = 0;
+    const ModuleMap::Module* module = nullptr;
+    bool consistent = false;
+    for (int retry = 0; retry < kReadRetries && !consistent; ++retry) {
+      uint32_t seq = entry.seq.load(std::memory_order_acquire);
+      if (seq == 0 || (seq & 1) != 0) {
+        continue;
+      }
+      native = entry.native.load(std::memory_order_relaxed);
+      module = entry.module.load(std::memory_order_relaxed);
+      record.time_ns = entry.time_ns.load(std::memory_order_relaxed);
+      record.tid = entry.tid.load(std::memory_order_relaxed);
+      record.registrations = entry.registrations.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      consistent = entry.seq.load(std::memory_order_relaxed) == seq;
+    }
+    const char* name = entry.name.load(std::memory_order_acquire);
+    if (!consistent || name == nullptr) {
+      continue;
+    }
+    record.header.type = kRecordNative;
+    record.method = method;
+    record.native = native;
+    record.offset = module != nullptr ? native - module->bias : native;
+    record.name_length = static_cast<uint32_t>(strlen(name));
+    record.module_length = module != nullptr ? static_cast<uint32_t>(module->name.size()) : 0;
+    record.header.size = sizeof(record) + record.name_length + record.module_length;
+    AppendBytes(&records, &record, sizeof(record));
+    AppendBytes(&records, name, record.name_length);
+    if (module != nullptr) {
+      AppendBytes(&records, module->name.data(), record.module_length);
+    }
+  }
+
+  std::vector<uint8_t> snapshot;
+  TraceFileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kTraceFileMagic;
+  header.version = kTraceVersion;
+  header.header_size = sizeof(header);
+  header.pid = getpid();
+  header.start_ns = NanoTime();
+  AppendBytes(&snapshot, &header, sizeof(header));
+  TraceChunkHeader chunk;
+  chunk.magic = kTraceChunkMagic;
+  chunk.tid = static_cast<uint32_t>(GetTid());
+  chunk.size = static_cast<uint32_t>(records.size());
+  chunk.dropped = 0;
+  AppendBytes(&snapshot, &chunk, sizeof(chunk));
+  snapshot.insert(snapshot.end(), records.begin(), records.end());
+  return snapshot;
+}
+
+bool NativeRegistry::Dump() {
+  std::vector<uint8_t> snapshot = Snapshot();
+  const char* package_name = ArtMethod::GetPackageName();
+  char path[PATH_MAX];
+  snprintf(path, sizeof(path), "/sdcard/Android/data/%s/files/trace", package_name);
+  mkdir(path, 0777);
+  snprintf(path, sizeof(path), "/sdcard/Android/data/%s/files/trace/mikrom_%d.natives",
+           package_name, getpid());
+  // Written next to the target and renamed, so a reader never sees half a snapshot.
+  std::string temp_path = std::string(path) + ".tmp";
+  int fd = open(temp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0666);
+  if (fd < 0) {
+    PLOG(ERROR) << "mikrom NativeRegistry open " << temp_path << " failed";
+    return false;
+  }
+  bool ok = WriteFully(fd, snapshot.data(), snapshot.size());
+  close(fd);
+  if (!ok || rename(temp_path.c_str(), path) != 0) {
+    PLOG(ERROR) << "mikrom NativeRegistry write " << path << " failed";
+    unlink(temp_path.c_str());
+    return false;
+  }
+  LOG(ERROR) << "mikrom NativeRegistry wrote " << snapshot.size() << " bytes to " << path;
+  return true;
+}
+
+}  // namespace mikrom
+}  // namespace art
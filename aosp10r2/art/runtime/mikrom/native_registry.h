@@ -0,0 +1,39 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_NATIVE_REGISTRY_H_
+#define ART_RUNTIME_MIKROM_NATIVE_REGISTRY_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/locks.h"
+
+namespace art {
+
+class ArtMethod;
+
+namespace mikrom {
+
+// isRegisterNativePrint support: the current native binding of every method
+// registered through RegisterNatives, with the module and offset of the native
+// code and the time and thread of the last (un)registration. Entries are claimed
+// with a CAS and updated under a per-entry sequence count, so registration never
+// blocks. Snapshot() returns the table as a trace file of NativeRecords; Dump()
+// writes it to mikrom_<pid>.natives in the trace directory when MikRomService asks
+// (MikRomManager.requestNativeRegistryDump), for mikromtrace natives to decode.
+class NativeRegistry {
+ public:
+  static constexpr uint32_t kMaxMethods = 1u << 15;
+
+  static void Register(ArtMethod* method, const void* native_method)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+  static void Unregister(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  static std::vector<uint8_t> Snapshot();
+  static bool Dump();
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_NATIVE_REGISTRY_H_
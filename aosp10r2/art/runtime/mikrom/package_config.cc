@@ -0,0 +1,167 @@
+// change mikrom
+#include "mikrom/package_config.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+
+#include <android-base/logging.h>
+#include <android-base/stringprintf.h>
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+using android::base::StringPrintf;
+
+struct EntryHeader {
+  uint8_t type;
+  uint8_t key_length;
+  uint16_t reserved;
+  uint32_t value_length;
+};
+
+// Maps the keys of the flat format, i.e. the PackageItem field names, to members.
+struct BoolKey {
+  const char* name;
+  bool PackageConfig::*member;
+};
+struct IntKey {
+  const char* name;
+  int PackageConfig::*member;
+};
+struct StringKey {
+  const char* name;
+  std::string PackageConfig::*member;
+};
+
+static const BoolKey kBoolKeys[] = {
+  {"isTuoke", &PackageConfig::is_tuoke},
+  {"isDeep", &PackageConfig::is_deep},
+  {"isInvokePrint", &PackageConfig::is_invoke_print},
+  {"isRegisterNativePrint", &PackageConfig::is_register_native_print},
+  {"isJNIMethodPrint", &PackageConfig::is_jni_method_print},
+};
+static const IntKey kIntKeys[] = {
+  {"debugWaitTimeout", &PackageConfig::debug_wait_timeout},
+  {"traceMode", &PackageConfig::trace_mode},
+  {"traceSampleRate", &PackageConfig::trace_sample_rate},
+  {"jniTraceMode", &PackageConfig::jni_trace_mode},
+  {"jniDataMaxBytes", &PackageConfig::jni_data_max_bytes},
+  {"jniDataSampleRate", &PackageConfig::jni_data_sample_rate},
+};
+static const StringKey kStringKeys[] = {
+  {"packageName", &PackageConfig::package_name},
+  {"appName", &PackageConfig::app_name},
+  {"traceMethod", &PackageConfig::trace_method},
+  {"sleepNativeMethod", &PackageConfig::debug_method},
+  {"jniTraceLibs", &PackageConfig::jni_trace_libs},
+  {"jniTraceMethods", &PackageConfig::jni_trace_methods},
+};
+
+template <typename Key, size_t kCount>
+static const Key* FindKey(const Key (&keys)[kCount], const char* key, size_t key_length) {
+  for (const Key& candidate : keys) {
+    if (strlen(candidate.name) == key_length && memcmp(candidate.name, key, key_length) == 0) {
+      return &candidate;
+    }
+  }
+  return nullptr;
+}
+
+static const PackageConfig kEmptyConfig;
+static std::atomic<const PackageConfig*> g_current{&kEmptyConfig};
+static std::atomic<uint32_t> g_version{0};
+
+}  // namespace
+
+const PackageConfig& PackageConfig::Current() {
+  return *g_current.load(std::memory_order_acquire);
+}
+
+void PackageConfig::Publish(PackageConfig* config) {
+  config->version = g_version.fetch_add(1, std::memory_order_relaxed) + 1;
+  // The previous config is left alone, see the class comment.
+  g_current.store(config, std::memory_order_release);
+  LOG(ERROR) << "mikrom config v" << config->version
+             << " package:" << config->package_name
+             << " isDeep:" << config->is_deep
+             << " debugMethod:" << config->debug_method
+             << " debugWaitTimeout:" << config->debug_wait_timeout
+             << " traceMethod:" << config->trace_method
+             << " traceMode:" << config->trace_mode
+             << " traceSampleRate:" << config->trace_sample_rate
+             << " isJNIMethodPrint:" << config->is_jni_method_print
+             << " jniTraceMode:" << config->jni_trace_mode
+             << " jniTraceLibs:" << config->jni_trace_libs
+             << " jniTraceMethods:" << config->jni_trace_methods
+             << " jniDataMaxBytes:" << config->jni_data_max_bytes
+             << " jniDataSampleRate:" << config->jni_data_sample_rate
+             << " isRegisterNativePrint:" << config->is_register_native_print;
+}
+
+bool PackageConfig::Load(const uint8_t* data, size_t size, std::string* error) {
+  uint32_t header[3];
+  if (data == nullptr || size < sizeof(header)) {
+    *error = "truncated header";
+    return false;
+  }
+  memcpy(header, data, sizeof(header));
+  if (header[0] != kMagic || header[1] != kFormatVersion) {
+    *error = StringPrintf("bad magic %08x or version %u", header[0], header[1]);
+    return false;
+  }
+  std::unique_ptr<PackageConfig> config(new PackageConfig(Current()));
+  size_t offset = sizeof(header);
+  for (uint32_t i = 0; i < header[2]; ++i) {
+    EntryHeader entry;
+    if (size - offset < sizeof(entry)) {
+      *error = StringPrintf("truncated entry %u", i);
+      return false;
+    }
+    memcpy(&entry, data + offset, sizeof(entry));
+    offset += sizeof(entry);
+    if (size - offset < static_cast<size_t>(entry.key_length) + entry.value_length) {
+      *error = StringPrintf("truncated entry %u", i);
+      return false;
+    }
+    const char* key = reinterpret_cast<const char*>(data + offset);
+    const uint8_t* value = data + offset + entry.key_length;
+    offset += entry.key_length + entry.value_length;
+    switch (entry.type) {
+      case kBool: {
+        const BoolKey* known = FindKey(kBoolKeys, key, entry.key_length);
+        if (known != nullptr && entry.value_length == 1) {
+          (*config).*(known->member) = value[0] != 0;
+        }
+        break;
+      }
+      case kInt: {
+        const IntKey* known = FindKey(kIntKeys, key, entry.key_length);
+        if (known != nullptr && entry.value_length == sizeof(int32_t)) {
+          int32_t v;
+          memcpy(&v, value, sizeof(v));
+          (*config).*(known->member) = v;
+        }
+        break;
+      }
+      case kString: {
+        const StringKey* known = FindKey(kStringKeys, key, entry.key_length);
+        if (known != nullptr) {
+          ((*config).*(known->member)).assign(reinterpret_cast<const char*>(value),
+                                              entry.value_length);
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  Publish(config.release());
+  return true;
+}
+
+}  // namespace mikrom
+}  // namespace art
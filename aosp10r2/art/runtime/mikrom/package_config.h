@@ -0,0 +1,70 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_PACKAGE_CONFIG_H_
+#define ART_RUNTIME_MIKROM_PACKAGE_CONFIG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace art {
+namespace mikrom {
+
+// The mik.conf settings of the current package, read through the ArtMethod
+// getters. A published config is never modified: an update builds a new one
+// and swaps the pointer, so readers take no lock and never see half of an
+// update. Replaced configs are not freed since callers keep the strings they
+// got from them; updates are rare and a config is a few KB at most.
+//
+// Across a reload, the flags read on each call follow at once; traceMethod and
+// traceMode are matched again per method, and the JNI filter and payload limits
+// are rebuilt by JniTrace::Start(). Call and JNI tracing start on the first
+// config that enables them and are not stopped; jniTraceMode and
+// sleepNativeMethod are taken from that first config only.
+struct PackageConfig {
+  // Flat format built by MikRomService.getPackageConfig(), little endian:
+  //   uint32 magic, uint32 format version, uint32 entry count, then per entry
+  //   uint8 type, uint8 key length, uint16 reserved, uint32 value length,
+  //   the key (a PackageItem field name) and the value. Unknown keys are skipped.
+  static constexpr uint32_t kMagic = 0x434b494d;  // "MIKC"
+  static constexpr uint32_t kFormatVersion = 1;
+  enum ValueType : uint8_t {
+    kBool = 0,    // 1 byte
+    kInt = 1,     // int32
+    kString = 2,  // UTF-8, not terminated
+  };
+
+  // Never null; an empty config until the first Publish().
+  static const PackageConfig& Current();
+
+  // Makes |config| current and takes ownership of it.
+  static void Publish(PackageConfig* config);
+
+  // Applies the entries of the flat format on top of the current config and
+  // publishes the result, so a snapshot may carry only the fields that changed.
+  static bool Load(const uint8_t* data, size_t size, std::string* error);
+
+  uint32_t version = 0;  // Assigned by Publish(), 0 for the initial empty config.
+  std::string package_name;
+  std::string app_name;
+  std::string trace_method;
+  std::string debug_method;
+  int debug_wait_timeout = 0;
+  bool is_tuoke = false;
+  bool is_deep = false;
+  bool is_invoke_print = false;
+  bool is_register_native_print = false;
+  bool is_jni_method_print = false;
+  int trace_mode = 0;
+  int trace_sample_rate = 0;
+  int jni_trace_mode = 0;
+  std::string jni_trace_libs;
+  std::string jni_trace_methods;
+  int jni_data_max_bytes = 0;
+  int jni_data_sample_rate = 0;
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_PACKAGE_CONFIG_H_
@@ -0,0 +1,92 @@
+// change mikrom
+#include "mikrom/sampling.h"
+
+#include <unistd.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <android-base/logging.h>
+
+#include "art_method-inl.h"
+#include "dex/code_item_accessors-inl.h"
+#include "mikrom/method_table.h"
+#include "mikrom/trace_buffer.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+static constexpr size_t kMaxRecordSize = (1u << 24) - 1;
+static constexpr int kSnapshotIntervalMs = 1000;
+
+static IdTable<MethodSamples> g_methods;
+static std::once_flag g_writer_once;
+static thread_local uint32_t tls_countdown = 0;
+
+static void WriteSnapshot(uint32_t id, MethodSamples* samples) {
+  if (!samples->TakeDirty()) {
+    return;
+  }
+  std::vector<SampleEntry> entries;
+  size_t max_entries = (kMaxRecordSize - sizeof(SamplesRecord)) / sizeof(SampleEntry);
+  for (uint32_t pc = 0; pc < samples->InsnsSize() && entries.size() < max_entries; ++pc) {
+    uint32_t count = samples->Count(pc);
+    if (count != 0) {
+      entries.push_back({pc, count});
+    }
+  }
+  SamplesRecord record;
+  record.header.type = kRecordSamples;
+  record.header.size = sizeof(record) + entries.size() * sizeof(SampleEntry);
+  record.method_id = id;
+  record.entry_count = static_cast<uint32_t>(entries.size());
+  TraceBuffer::Append(&record, sizeof(record), entries.data(), entries.size() * sizeof(SampleEntry));
+}
+
+static void WriterLoop() {
+  while (true) {
+    usleep(kSnapshotIntervalMs * 1000);
+    g_methods.VisitAll(WriteSnapshot);
+  }
+}
+
+}  // namespace
+
+void Sampling::Register(ArtMethod* method, uint32_t method_id) {
+  CodeItemInstructionAccessor accessor = method->DexInstructions();
+  if (!accessor.HasCodeItem() || accessor.InsnsSizeInCodeUnits() == 0) {
+    return;
+  }
+  std::unique_ptr<MethodSamples> samples(new MethodSamples());
+  samples->insns_size_ = accessor.InsnsSizeInCodeUnits();
+  samples->counts_.reset(new std::atomic<uint32_t>[samples->insns_size_]);
+  for (uint32_t i = 0; i < samples->insns_size_; ++i) {
+    samples->counts_[i].store(0, std::memory_order_relaxed);
+  }
+  if (!g_methods.Set(method_id, samples.get())) {
+    return;
+  }
+  samples.release();
+  LOG(ERROR) << "mikrom sampling method:" << method->PrettyMethod() << " id:" << method_id
+             << " rate:" << Rate();
+  std::call_once(g_writer_once, [] { std::thread(WriterLoop).detach(); });
+}
+
+MethodSamples* Sampling::ForMethod(uint32_t method_id) {
+  return g_methods.Get(method_id);
+}
+
+uint32_t Sampling::Rate() {
+  int rate = ArtMethod::GetTraceSampleRate();
+  return rate > 0 ? static_cast<uint32_t>(rate) : kDefaultRate;
+}
+
+uint32_t& Sampling::ThreadCountdown() {
+  return tls_countdown;
+}
+
+}  // namespace mikrom
+}  // namespace art
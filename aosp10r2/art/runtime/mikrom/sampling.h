@@ -0,0 +1,78 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_SAMPLING_H_
+#define ART_RUNTIME_MIKROM_SAMPLING_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "base/locks.h"
+#include "base/macros.h"
+
+namespace art {
+
+class ArtMethod;
+
+namespace mikrom {
+
+// dex_pc histogram of one method traced in sampling mode.
+class MethodSamples {
+ public:
+  ALWAYS_INLINE void Hit(uint32_t dex_pc) {
+    if (LIKELY(dex_pc < insns_size_)) {
+      counts_[dex_pc].fetch_add(1, std::memory_order_relaxed);
+      dirty_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  uint32_t InsnsSize() const {
+    return insns_size_;
+  }
+
+  uint32_t Count(uint32_t dex_pc) const {
+    return counts_[dex_pc].load(std::memory_order_relaxed);
+  }
+
+  // Returns whether a sample was taken since the previous call.
+  bool TakeDirty() {
+    return dirty_.exchange(false, std::memory_order_relaxed);
+  }
+
+ private:
+  MethodSamples() {}
+
+  uint32_t insns_size_ = 0;
+  std::unique_ptr<std::atomic<uint32_t>[]> counts_;
+  std::atomic<bool> dirty_{false};
+
+  friend class Sampling;
+};
+
+// Sampling mode (traceMode 2): methods matching traceMethod record one in every
+// traceSampleRate executed instructions into a per-method dex_pc histogram, which
+// bounds the cost for long running dispatch loops. Histograms are written to the
+// trace file as SamplesRecords every second while they change; mikromtrace
+// profile prints the hot instructions.
+class Sampling {
+ public:
+  static constexpr uint32_t kDefaultRate = 1000;
+
+  // Called once for every method SmaliTrace assigns |method_id| to.
+  static void Register(ArtMethod* method, uint32_t method_id) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Returns the histogram of |method_id|, or null if it is not registered (yet).
+  static MethodSamples* ForMethod(uint32_t method_id);
+
+  // Instructions between two samples, from traceSampleRate.
+  static uint32_t Rate() REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // The countdown to the next sample is per thread and carried across frames, so
+  // that short frames are sampled as fairly as long ones.
+  static uint32_t& ThreadCountdown();
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_SAMPLING_H_
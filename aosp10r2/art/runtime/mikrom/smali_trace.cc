@@ -0,0 +1,193 @@
+// change mikrom
+#include "mikrom/smali_trace.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include <android-base/logging.h>
+
+#include "art_method-inl.h"
+#include "class_linker.h"
+#include "dex/code_item_accessors-inl.h"
+#include "dex/dex_file.h"
+#include "entrypoints/runtime_asm_entrypoints.h"
+#include "gc/scoped_gc_critical_section.h"
+#include "instrumentation.h"
+#include "mikrom/coverage.h"
+#include "mikrom/method_table.h"
+#include "mikrom/package_config.h"
+#include "mikrom/sampling.h"
+#include "mirror/class-inl.h"
+#include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread_list.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+// Returned for methods that are not traced.
+static constexpr uint32_t kNotTraced = 0;
+static constexpr size_t kMaxRecordSize = (1u << 24) - 1;
+
+// Trace ids of the methods that matched traceMethod at some point. An id stays
+// with its method, so a method traced again after a reload keeps its record.
+static PointerTable g_method_ids(/* capacity_log2= */ 16, /* max_capacity_log2= */ 22);
+// The match of every method run, as the PackageConfig version shifted left by
+// one and the traced bit, so a reload of traceMethod re-evaluates each method
+// once. Holds untraced methods too, so it grows with the number of methods run.
+static PointerTable g_decisions(/* capacity_log2= */ 16, /* max_capacity_log2= */ 22);
+static std::mutex g_register_lock;
+static uint32_t g_next_method_id = 1;  // Guarded by g_register_lock.
+static std::atomic<bool> g_table_full_logged{false};
+// Whether the app classes linked before traceMethod was set were moved to the
+// interpreter. Cleared when traceMethod is, since LinkCode() stops forcing it.
+static std::atomic<bool> g_interpreting{false};
+
+static void LogFull() {
+  if (!g_table_full_logged.exchange(true)) {
+    LOG(ERROR) << "mikrom smaliTrace method table is full, new methods are not traced";
+  }
+}
+
+// LinkCode() only forces the interpreter for classes linked while traceMethod is
+// set; this puts the app classes linked before back on the interpreter entry
+// point so their traced methods are seen. Boot classes keep their compiled code,
+// as they do in LinkCode(), and static methods of uninitialized classes are left
+// to FixupStaticTrampolines().
+class InterpreterEntryVisitor : public ClassVisitor {
+ public:
+  explicit InterpreterEntryVisitor(ClassLinker* class_linker) : class_linker_(class_linker) {}
+
+  bool operator()(ObjPtr<mirror::Class> klass) override REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (klass->GetClassLoader() == nullptr || klass->IsProxyClass() || !klass->IsResolved()) {
+      return true;
+    }
+    instrumentation::Instrumentation* instrumentation = Runtime::Current()->GetInstrumentation();
+    for (ArtMethod& method : klass->GetDeclaredMethods(class_linker_->GetImagePointerSize())) {
+      if (!method.IsInvokable() || method.IsNative()) {
+        continue;
+      }
+      const void* code = method.GetEntryPointFromQuickCompiledCode();
+      if (class_linker_->IsQuickResolutionStub(code) ||
+          class_linker_->IsQuickToInterpreterBridge(code)) {
+        continue;
+      }
+      instrumentation->UpdateMethodsCode(&method, GetQuickToInterpreterBridge());
+      ++count_;
+    }
+    return true;
+  }
+
+  size_t count_ = 0;
+
+ private:
+  ClassLinker* const class_linker_;
+};
+
+static void WriteMethodRecord(ArtMethod* method, uint32_t method_id)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  CodeItemInstructionAccessor accessor = method->DexInstructions();
+  uint32_t insns_size = accessor.HasCodeItem() ? accessor.InsnsSizeInCodeUnits() : 0u;
+  size_t max_insns = (kMaxRecordSize - sizeof(MethodRecord)) / sizeof(uint16_t);
+  if (insns_size > max_insns) {
+    insns_size = static_cast<uint32_t>(max_insns);
+  }
+  MethodRecord record;
+  record.header.type = kRecordMethod;
+  record.header.size = sizeof(record) + insns_size * sizeof(uint16_t);
+  record.method_id = method_id;
+  record.dex_checksum = method->GetDexFile()->GetHeader().checksum_;
+  record.method_idx = method->GetDexMethodIndex();
+  record.insns_size = insns_size;
+  TraceBuffer::Append(&record, sizeof(record), accessor.Insns(), insns_size * sizeof(uint16_t));
+}
+
+}  // namespace
+
+void SmaliTrace::Start(Thread* self) {
+  {
+    ScopedObjectAccess soa(self);
+    if (PackageConfig::Current().trace_method.empty()) {
+      g_interpreting.store(false, std::memory_order_relaxed);
+      return;
+    }
+  }
+  if (g_interpreting.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  InterpreterEntryVisitor visitor(class_linker);
+  {
+    gc::ScopedGCCriticalSection gcs(self,
+                                    gc::kGcCauseInstrumentation,
+                                    gc::kCollectorTypeInstrumentation);
+    ScopedSuspendAll ssa(__FUNCTION__);
+    class_linker->VisitClasses(&visitor);
+  }
+  LOG(ERROR) << "mikrom smaliTrace moved " << visitor.count_ << " methods to the interpreter";
+}
+
+uint32_t SmaliTrace::MethodId(ArtMethod* method) {
+  // One snapshot for the pattern and its version, see PackageConfig.
+  const PackageConfig& config = PackageConfig::Current();
+  if (LIKELY(config.trace_method.empty())) {
+    return kNotTraced;
+  }
+  const uint32_t version_bits = config.version << 1;
+  uint32_t decision;
+  uint32_t id;
+  if (LIKELY(g_decisions.Lookup(method, &decision)) && (decision & ~1u) == version_bits) {
+    if ((decision & 1u) == 0) {
+      return kNotTraced;
+    }
+    // Traced decisions are stored after the id.
+    if (LIKELY(g_method_ids.Lookup(method, &id))) {
+      return id;
+    }
+  }
+  std::string pretty = method->PrettyMethod();
+  bool traced = strstr(pretty.c_str(), config.trace_method.c_str()) != nullptr;
+  bool first = false;
+  {
+    // Ids are only taken once the method is in the table, so a full table never
+    // hands out a second id for a method or writes its MethodRecord again.
+    std::lock_guard<std::mutex> guard(g_register_lock);
+    id = kNotTraced;
+    if (traced && !g_method_ids.Lookup(method, &id)) {
+      id = g_next_method_id;
+      if (!g_method_ids.Insert(method, &id)) {
+        LogFull();
+        return kNotTraced;
+      }
+      ++g_next_method_id;
+      first = true;
+    }
+    if (!g_decisions.Set(method, version_bits | (traced ? 1u : 0u))) {
+      // Only costs matching the method again on its next call.
+      LogFull();
+    }
+  }
+  if (!traced) {
+    return kNotTraced;
+  }
+  if (first) {
+    LOG(ERROR) << "mikrom smaliTrace method:" << pretty << " id:" << id;
+    WriteMethodRecord(method, id);
+  }
+  // Both ignore a method registered before, so a traceMode reload picks the
+  // method up for the new mode.
+  if (config.trace_mode == kTraceModeCoverage) {
+    Coverage::Register(method, id);
+  } else if (config.trace_mode == kTraceModeSampling) {
+    Sampling::Register(method, id);
+  }
+  return id;
+}
+
+}  // namespace mikrom
+}  // namespace art
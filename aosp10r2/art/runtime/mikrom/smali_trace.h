@@ -0,0 +1,55 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_SMALI_TRACE_H_
+#define ART_RUNTIME_MIKROM_SMALI_TRACE_H_
+
+#include <stdint.h>
+
+#include "base/locks.h"
+#include "base/macros.h"
+#include "mikrom/trace_buffer.h"
+
+namespace art {
+
+class ArtMethod;
+class Thread;
+
+namespace mikrom {
+
+// Values of the traceMode config field.
+enum TraceMode {
+  kTraceModeInstruction = 0,  // Every executed instruction, see SmaliTrace.
+  kTraceModeCoverage = 1,     // Basic blocks hit, see Coverage.
+  kTraceModeSampling = 2,     // dex_pc histogram of every Nth instruction, see Sampling.
+  kTraceModeCalls = 3,        // Method entry/exit events, see CallTrace.
+  kTraceModeFields = 4,       // Field reads and writes with their values, see FieldTrace.
+};
+
+// Instruction trace for methods matching traceMethod. The device only records
+// (method id, dex_pc); the method itself is described once by a MethodRecord
+// carrying its dex checksum, method_idx and instructions. tools/mikrom/mikromtrace
+// turns that back into the annotated smali listing on the host.
+class SmaliTrace {
+ public:
+  // Moves the app classes linked before traceMethod was set to the interpreter,
+  // once. Called whenever a config is loaded.
+  static void Start(Thread* self) REQUIRES(!Locks::mutator_lock_);
+
+  // Returns the trace id of |method|, or 0 if it is not traced. The
+  // PrettyMethod()/strstr() match runs once per method and config version,
+  // later calls are a lock-free table lookup.
+  static uint32_t MethodId(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  ALWAYS_INLINE static void RecordInstruction(uint32_t method_id, uint32_t dex_pc) {
+    InstructionRecord record;
+    record.header.type = kRecordInstruction;
+    record.header.size = sizeof(record);
+    record.method_id = method_id;
+    record.dex_pc = dex_pc;
+    TraceBuffer::Append(&record, sizeof(record));
+  }
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_SMALI_TRACE_H_
@@ -0,0 +1,244 @@
+// change mikrom
+#include "mikrom/trace_buffer.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <android-base/logging.h>
+
+#include "art_method.h"
+#include "base/time_utils.h"
+#include "base/utils.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+// Must be a power of two.
+static constexpr size_t kRingSize = 512 * 1024;
+// Records bigger than this bypass the ring and are written synchronously.
+static constexpr size_t kMaxRingRecord = kRingSize / 4;
+static constexpr int kFlushIntervalMs = 100;
+
+struct ThreadRing {
+  explicit ThreadRing(uint32_t thread_id) : tid(thread_id) {}
+
+  const uint32_t tid;
+  std::atomic<uint64_t> head{0};  // Written by the owning thread only.
+  std::atomic<uint64_t> tail{0};  // Written by the flusher only.
+  std::atomic<uint32_t> dropped{0};
+  std::atomic<bool> dead{false};
+  uint8_t data[kRingSize];
+};
+
+struct RingHolder {
+  ThreadRing* ring = nullptr;
+  ~RingHolder() {
+    if (ring != nullptr) {
+      // The flusher drains and frees it.
+      ring->dead.store(true, std::memory_order_release);
+    }
+  }
+};
+
+static thread_local RingHolder tls_ring;
+
+static std::once_flag g_start_once;
+static std::atomic<int> g_fd{-1};
+static std::mutex g_write_lock;
+static std::mutex g_rings_lock;
+static std::vector<ThreadRing*> g_rings;
+static std::mutex g_wake_lock;
+static std::condition_variable g_wake_cond;
+static std::atomic<bool> g_wake_pending{false};
+
+static void WriteChunk(uint32_t tid,
+                       uint32_t dropped,
+                       const void* p1, size_t n1,
+                       const void* p2, size_t n2) {
+  TraceChunkHeader chunk;
+  chunk.magic = kTraceChunkMagic;
+  chunk.tid = tid;
+  chunk.size = static_cast<uint32_t>(n1 + n2);
+  chunk.dropped = dropped;
+  struct iovec iov[3];
+  iov[0].iov_base = &chunk;
+  iov[0].iov_len = sizeof(chunk);
+  iov[1].iov_base = const_cast<void*>(p1);
+  iov[1].iov_len = n1;
+  iov[2].iov_base = const_cast<void*>(p2);
+  iov[2].iov_len = n2;
+  std::lock_guard<std::mutex> guard(g_write_lock);
+  if (TEMP_FAILURE_RETRY(writev(g_fd.load(std::memory_order_relaxed), iov, 3)) < 0) {
+    PLOG(ERROR) << "mikrom TraceBuffer write failed";
+  }
+}
+
+static void DrainRing(ThreadRing* ring) {
+  uint64_t head = ring->head.load(std::memory_order_acquire);
+  uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+  uint32_t dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+  if (head == tail && dropped == 0) {
+    return;
+  }
+  size_t begin = tail & (kRingSize - 1);
+  size_t size = head - tail;
+  size_t first = std::min(size, kRingSize - begin);
+  WriteChunk(ring->tid, dropped, ring->data + begin, first, ring->data, size - first);
+  ring->tail.store(head, std::memory_order_release);
+}
+
+static void DrainAll() {
+  std::lock_guard<std::mutex> guard(g_rings_lock);
+  for (auto it = g_rings.begin(); it != g_rings.end();) {
+    ThreadRing* ring = *it;
+    // Read |dead| first so that nothing appended before the thread exited is lost.
+    bool dead = ring->dead.load(std::memory_order_acquire);
+    DrainRing(ring);
+    if (dead) {
+      delete ring;
+      it = g_rings.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+static void FlusherLoop() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(g_wake_lock);
+      g_wake_cond.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs), [] {
+        return g_wake_pending.load(std::memory_order_relaxed);
+      });
+      g_wake_pending.store(false, std::memory_order_relaxed);
+    }
+    DrainAll();
+  }
+}
+
+static void WakeFlusher() {
+  if (!g_wake_pending.exchange(true, std::memory_order_relaxed)) {
+    g_wake_cond.notify_one();
+  }
+}
+
+static void Start() {
+  const char* package_name = ArtMethod::GetPackageName();
+  char path[PATH_MAX];
+  snprintf(path, sizeof(path), "/sdcard/Android/data/%s/files/trace", package_name);
+  mkdir(path, 0777);
+  snprintf(path, sizeof(path), "/sdcard/Android/data/%s/files/trace/mikrom_%d.trace",
+           package_name, getpid());
+  int fd = open(path, O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0666);
+  if (fd < 0) {
+    PLOG(ERROR) << "mikrom TraceBuffer open " << path << " failed";
+    return;
+  }
+  TraceFileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kTraceFileMagic;
+  header.version = kTraceVersion;
+  header.header_size = sizeof(header);
+  header.pid = getpid();
+  header.start_ns = NanoTime();
+  if (TEMP_FAILURE_RETRY(write(fd, &header, sizeof(header))) != sizeof(header)) {
+    PLOG(ERROR) << "mikrom TraceBuffer write header failed";
+    close(fd);
+    return;
+  }
+  g_fd.store(fd, std::memory_order_release);
+  std::thread(FlusherLoop).detach();
+  LOG(ERROR) << "mikrom TraceBuffer writing to " << path;
+}
+
+static ThreadRing* CurrentRing() {
+  ThreadRing* ring = tls_ring.ring;
+  if (LIKELY(ring != nullptr)) {
+    return ring;
+  }
+  std::call_once(g_start_once, Start);
+  if (g_fd.load(std::memory_order_acquire) < 0) {
+    return nullptr;
+  }
+  ring = new ThreadRing(static_cast<uint32_t>(GetTid()));
+  {
+    std::lock_guard<std::mutex> guard(g_rings_lock);
+    g_rings.push_back(ring);
+  }
+  tls_ring.ring = ring;
+  return ring;
+}
+
+}  // namespace
+
+void TraceBuffer::Append(const void* head, size_t head_size, const void* body, size_t body_size) {
+  ThreadRing* ring = CurrentRing();
+  if (UNLIKELY(ring == nullptr)) {
+    return;
+  }
+  size_t size = head_size + body_size;
+  if (UNLIKELY(size > kMaxRingRecord)) {
+    // Keep ordering with what this thread already buffered.
+    {
+      std::lock_guard<std::mutex> guard(g_rings_lock);
+      DrainRing(ring);
+    }
+    WriteChunk(ring->tid, 0, head, head_size, body, body_size);
+    return;
+  }
+  uint64_t pos = ring->head.load(std::memory_order_relaxed);
+  uint64_t tail = ring->tail.load(std::memory_order_acquire);
+  if (UNLIKELY(kRingSize - (pos - tail) < size)) {
+    ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    WakeFlusher();
+    return;
+  }
+  const uint8_t* parts[2] = { static_cast<const uint8_t*>(head),
+                              static_cast<const uint8_t*>(body) };
+  size_t lengths[2] = { head_size, body_size };
+  for (size_t i = 0; i < 2; ++i) {
+    const uint8_t* src = parts[i];
+    size_t length = lengths[i];
+    while (length > 0) {
+      size_t offset = pos & (kRingSize - 1);
+      size_t n = std::min(length, kRingSize - offset);
+      memcpy(ring->data + offset, src, n);
+      src += n;
+      length -= n;
+      pos += n;
+    }
+  }
+  ring->head.store(pos, std::memory_order_release);
+  if (UNLIKELY(pos - tail > kRingSize / 2)) {
+    WakeFlusher();
+  }
+}
+
+void TraceBuffer::Append(const void* record, size_t size) {
+  Append(record, size, nullptr, 0);
+}
+
+void TraceBuffer::Flush() {
+  int fd = g_fd.load(std::memory_order_acquire);
+  if (fd >= 0) {
+    DrainAll();
+    fsync(fd);
+  }
+}
+
+}  // namespace mikrom
+}  // namespace art
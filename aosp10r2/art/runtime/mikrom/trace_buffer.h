@@ -0,0 +1,33 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_TRACE_BUFFER_H_
+#define ART_RUNTIME_MIKROM_TRACE_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mikrom/trace_format.h"
+
+namespace art {
+namespace mikrom {
+
+// Process wide binary trace sink. Each thread appends into its own ring buffer
+// without taking locks; a background thread drains the rings into
+// /sdcard/Android/data/<package>/files/trace/mikrom_<pid>.trace.
+// When a ring is full the record is dropped and counted instead of blocking the
+// traced thread.
+class TraceBuffer {
+ public:
+  // Appends one complete record. |record| must start with a RecordHeader.
+  static void Append(const void* record, size_t size);
+
+  // Appends a record made of a fixed part followed by a variable payload.
+  static void Append(const void* head, size_t head_size, const void* body, size_t body_size);
+
+  // Writes everything buffered so far to the trace file.
+  static void Flush();
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_TRACE_BUFFER_H_
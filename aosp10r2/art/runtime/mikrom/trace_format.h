@@ -0,0 +1,241 @@
+// change mikrom
+#ifndef ART_RUNTIME_MIKROM_TRACE_FORMAT_H_
+#define ART_RUNTIME_MIKROM_TRACE_FORMAT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// On-disk layout of the mikrom binary trace. The file is written by the runtime
+// (mikrom/trace_buffer.cc) and decoded on the host by tools/mikrom/mikromtrace.
+//
+//   TraceFileHeader
+//   { TraceChunkHeader, records... }*
+//
+// Every chunk holds the records of one thread. A record starts with a RecordHeader
+// whose size covers the header itself, so unknown record types can be skipped.
+// The mikrom_<pid>.jnidata side file (mikrom/jni_data.cc) has the same layout and
+// only holds JniDataRecords.
+namespace art {
+namespace mikrom {
+
+static constexpr uint32_t kTraceFileMagic = 0x52544b4d;   // "MKTR"
+static constexpr uint32_t kTraceChunkMagic = 0x43544b4d;  // "MKTC"
+static constexpr uint16_t kTraceVersion = 1;
+
+struct TraceFileHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t header_size;
+  uint32_t pid;
+  uint32_t reserved;
+  uint64_t start_ns;
+};
+
+struct TraceChunkHeader {
+  uint32_t magic;
+  uint32_t tid;
+  uint32_t size;     // Bytes of records following this header.
+  uint32_t dropped;  // Records this thread dropped since its previous chunk.
+};
+
+enum RecordType : uint8_t {
+  kRecordMethod = 1,       // MethodRecord + uint16_t insns[insns_size]
+  kRecordInstruction = 2,  // InstructionRecord
+  kRecordBlocks = 3,       // BlocksRecord + uint32_t block_start[block_count]
+  kRecordCoverage = 4,     // CoverageRecord + uint32_t bits[(block_count + 31) / 32]
+  kRecordSamples = 5,      // SamplesRecord + SampleEntry entries[entry_count]
+  kRecordMethodEnter = 6,  // CallRecord
+  kRecordMethodExit = 7,   // CallRecord
+  kRecordMethodUnwind = 8, // CallRecord, the method exited by an exception.
+  kRecordField = 9,        // FieldRecord + char string[string_length]
+  kRecordJniString = 10,   // JniStringRecord + char data[length]
+  kRecordJniCall = 11,     // JniCallRecord + JniArg args[arg_count]
+  kRecordJniProfile = 12,  // JniProfileRecord
+  kRecordJniData = 13,     // JniDataRecord + uint8_t data[length], in the side file
+  kRecordNative = 14,      // NativeRecord + char name[name_length] + char module[module_length]
+  kRecordInvokeEdge = 15,  // InvokeEdgeRecord
+};
+
+struct RecordHeader {
+  uint32_t type : 8;
+  uint32_t size : 24;  // Whole record, header included.
+};
+
+// Emitted once per traced method. method_id is process local and is what the
+// per-instruction records refer to. The instructions are copied from memory, so
+// code items restored at runtime by a packer are decoded as they were executed.
+struct MethodRecord {
+  RecordHeader header;
+  uint32_t method_id;
+  uint32_t dex_checksum;
+  uint32_t method_idx;
+  uint32_t insns_size;  // In 16-bit code units.
+};
+
+struct InstructionRecord {
+  RecordHeader header;
+  uint32_t method_id;
+  uint32_t dex_pc;
+};
+
+// Basic blocks of a method traced in coverage mode, as dex_pc of their first
+// instruction in ascending order. Emitted once, right after the MethodRecord.
+struct BlocksRecord {
+  RecordHeader header;
+  uint32_t method_id;
+  uint32_t block_count;
+};
+
+// Snapshot of the blocks of a method hit so far, bit i standing for block i of
+// its BlocksRecord. Snapshots are cumulative: the last one of a method wins.
+struct CoverageRecord {
+  RecordHeader header;
+  uint32_t method_id;
+  uint32_t block_count;
+};
+
+// Histogram of the sampled dex_pcs of a method, only listing pcs with samples.
+// Snapshots are cumulative: the last one of a method wins.
+struct SamplesRecord {
+  RecordHeader header;
+  uint32_t method_id;
+  uint32_t entry_count;
+};
+
+struct SampleEntry {
+  uint32_t dex_pc;
+  uint32_t count;
+};
+
+// Entry or exit of a method traced in call mode. time_ns is CLOCK_MONOTONIC, the
+// same clock as TraceFileHeader::start_ns.
+struct CallRecord {
+  RecordHeader header;
+  uint32_t method_id;
+  uint64_t time_ns;
+};
+
+enum FieldAccess : uint8_t {
+  kFieldRead = 0,
+  kFieldWrite = 1,
+};
+
+// A field access of a method traced in field mode. The field is identified in the
+// dex declaring it. value holds primitives zero extended; for references it is the
+// identity hash of the value, and String contents follow the record.
+struct FieldRecord {
+  RecordHeader header;
+  uint32_t method_id;
+  uint64_t value;
+  uint32_t dex_pc;
+  uint32_t dex_checksum;
+  uint32_t field_idx;
+  uint32_t object_id;       // Identity hash of the receiver, 0 for static fields.
+  uint8_t access;           // FieldAccess
+  uint8_t type;             // Primitive::Type of the field.
+  uint16_t string_length;   // Bytes of modified UTF-8 following, if the value is a String.
+};
+
+// An entry of the JNI trace string table: the names of the JNI functions, of the
+// methods and fields they target, and the contents of String arguments. Events
+// refer to strings by id; an entry may come after the events using it.
+struct JniStringRecord {
+  RecordHeader header;
+  uint32_t string_id;
+  uint32_t length;  // Bytes of modified UTF-8 following.
+};
+
+// A call into the JNI function table made while isJNIMethodPrint is set.
+struct JniCallRecord {
+  RecordHeader header;
+  uint32_t function_id;    // String id of the JNI function name.
+  uint32_t target_id;      // String id of the method or field, 0 if there is none.
+  uint32_t arg_count;
+  uint32_t caller_module;  // String id of the path of the native caller, 0 if unknown.
+  uint64_t target;         // The jmethodID or jfieldID passed.
+  uint64_t caller_pc;      // Return address into the caller, relative to the load
+                           // bias of caller_module (absolute if it is unknown).
+};
+
+enum JniArgType : uint8_t {
+  kJniArgNull = 0,
+  kJniArgInt = 1,     // boolean, byte, char, short and int, sign extended.
+  kJniArgLong = 2,
+  kJniArgDouble = 3,  // float and double, as the bits of a double.
+  kJniArgObject = 4,  // Identity hash of the object.
+  kJniArgString = 5,  // String id of its contents.
+};
+
+struct JniArg {
+  uint64_t value;
+  uint8_t type;  // JniArgType
+  uint8_t reserved[7];
+};
+
+static constexpr size_t kJniLatencyBuckets = 32;
+
+// Calls counted in JNI profile mode (jniTraceMode 1) for one caller module, JNI
+// function and target. Snapshots are cumulative: the last one of an entry wins.
+// latency[0] counts calls under 1ns, latency[i] calls in [2^(i-1), 2^i) ns; the
+// last bucket is open ended.
+struct JniProfileRecord {
+  RecordHeader header;
+  uint32_t entry_id;
+  uint32_t function_id;    // String ids, as in JniCallRecord.
+  uint32_t target_id;
+  uint32_t caller_module;
+  uint64_t count;
+  uint64_t total_ns;
+  uint32_t latency[kJniLatencyBuckets];
+};
+
+enum JniDataFlags : uint32_t {
+  // The payload has the same content_hash as one written before and is left out.
+  kJniDataDuplicate = 1,
+};
+
+// Bytes passed to or returned by NewStringUTF, GetStringUTFChars,
+// GetByteArrayElements or SetByteArrayRegion, captured when jniDataMaxBytes is
+// set. The string ids refer to the main trace.
+struct JniDataRecord {
+  RecordHeader header;
+  uint32_t function_id;    // String ids, as in JniCallRecord.
+  uint32_t caller_module;
+  uint32_t length;         // Bytes captured, at most jniDataMaxBytes.
+  uint32_t total_length;   // Size of the whole string or array region.
+  uint32_t flags;          // JniDataFlags
+  uint64_t caller_pc;      // As in JniCallRecord.
+  uint64_t content_hash;   // Of the captured bytes and total_length.
+  uint64_t time_ns;
+};
+
+// Native binding of a method registered through RegisterNatives, as listed by
+// NativeRegistry::Snapshot() (mikrom_<pid>.natives). native is 0 once the
+// method was unregistered.
+struct NativeRecord {
+  RecordHeader header;
+  uint32_t tid;            // Thread of the last (un)registration.
+  uint32_t registrations;  // Times the method was registered.
+  uint32_t name_length;    // Bytes of PrettyMethod() following the record.
+  uint32_t module_length;  // Bytes of the module path following the name, 0 if unknown.
+  uint32_t reserved;
+  uint64_t method;         // The ArtMethod*.
+  uint64_t native;
+  uint64_t offset;         // native relative to the load bias of the module.
+  uint64_t time_ns;        // CLOCK_MONOTONIC of the last (un)registration.
+};
+
+// Calls through InvokeWithArgArray counted for one caller -> callee edge while
+// isInvokePrint is set. Snapshots are cumulative: the last one of an edge wins.
+struct InvokeEdgeRecord {
+  RecordHeader header;
+  uint32_t edge_id;
+  uint32_t caller_id;  // String ids (JniStringRecord) of the methods; the caller
+  uint32_t callee_id;  // is 0 when no managed frame was found.
+  uint64_t count;
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_RUNTIME_MIKROM_TRACE_FORMAT_H_
@@ -16,7 +16,13 @@
 
 #include "dalvik_system_DexFile.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
 #include <sstream>
+#include <string_view>
+#include <unordered_map>
 
 #include "android-base/stringprintf.h"
 
@@ -38,6 +44,14 @@
 #include "handle_scope-inl.h"
 #include "jit/debugger_interface.h"
 #include "jni/jni_internal.h"
+#include "mikrom/call_trace.h"
+#include "mikrom/class_matcher.h"
+#include "mikrom/debug_gate.h"
+#include "mikrom/jni_profile.h"
+#include "mikrom/jni_trace.h"
+#include "mikrom/native_registry.h"
+#include "mikrom/package_config.h"
+#include "mikrom/smali_trace.h"
 #include "mirror/class_loader.h"
 #include "mirror/object-inl.h"
 #include "mirror/string.h"
@@ -529,8 +543,40 @@ static jobjectArray DexFile_getClassNameList(JNIEnv* env, jclass, jobject cookie
   return result;
 }
 
+//按当前配置启动各项功能,每次加载配置都会调用。traceMethod,jni过滤和jni数据记录按新配置重新生成,
+//callTrace,jniTraceMode和sleepNativeMethod只在第一次启动时生效
+static void StartMikRom(JNIEnv* env){
+    mikrom::SmaliTrace::Start(Thread::Current());
+    mikrom::CallTrace::Start(Thread::Current());
+    mikrom::JniTrace::Start(Thread::Current());
+    ScopedObjectAccess soa(env);
+    mikrom::DebugGate::Init(ArtMethod::GetDebugMethod(), ArtMethod::GetDebugWaitTimeout());
+}
+
 static jboolean DexFile_setMikRomConfig(JNIEnv* env,jclass,jobject config){
     ArtMethod::SetPackageItem(env,config);
+    StartMikRom(env);
+    return JNI_TRUE;
+}
+
+//加载MikRomService.getPackageConfig生成的二进制配置,可在运行中重复调用来更新配置
+static jboolean DexFile_loadMikRomConfig(JNIEnv* env,jclass,jbyteArray data){
+    if(data==nullptr){
+        return JNI_FALSE;
+    }
+    jsize size=env->GetArrayLength(data);
+    jbyte* bytes=env->GetByteArrayElements(data,nullptr);
+    if(bytes==nullptr){
+        return JNI_FALSE;
+    }
+    std::string error;
+    bool loaded=mikrom::PackageConfig::Load(reinterpret_cast<const uint8_t*>(bytes),size,&error);
+    env->ReleaseByteArrayElements(data,bytes,JNI_ABORT);
+    if(!loaded){
+        LOG(ERROR)<<"mikrom loadMikRomConfig err:"<<error;
+        return JNI_FALSE;
+    }
+    StartMikRom(env);
     return JNI_TRUE;
 }
 
@@ -551,6 +597,229 @@ static void DexFile_dumpRepair(JNIEnv* env, jclass){
     dumpDexOver();
 }
 
+static void DexFile_dumpJniProfile(JNIEnv*, jclass){
+    mikrom::JniProfile::Dump();
+}
+
+//放行在sleepNativeMethod入口等待调试器的线程
+static void DexFile_releaseDebugGate(JNIEnv*, jclass){
+    mikrom::DebugGate::Release("release request");
+}
+
+//把当前所有RegisterNatives注册的方法写到trace目录的mikrom_<pid>.natives,用mikromtrace natives解析
+static jboolean DexFile_dumpNativeRegistry(JNIEnv*, jclass){
+    return mikrom::NativeRegistry::Dump() ? JNI_TRUE : JNI_FALSE;
+}
+
+//把Fartext的白名单或黑名单编译成自动机,返回句柄,没有有效的模式时返回0表示不过滤
+static jlong DexFile_compileClassMatcher(JNIEnv* env, jclass, jobjectArray patterns){
+    if(patterns==nullptr){
+        return 0;
+    }
+    std::vector<std::string> list;
+    jsize count=env->GetArrayLength(patterns);
+    for(jsize i=0;i<count;i++){
+        ScopedLocalRef<jstring> pattern(env,(jstring)env->GetObjectArrayElement(patterns,i));
+        NullableScopedUtfChars chars(env,pattern.get());
+        if(chars.c_str()!=nullptr){
+            list.push_back(chars.c_str());
+        }
+    }
+    return reinterpret_cast<jlong>(mikrom::ClassMatcher::Compile(list));
+}
+
+static void DexFile_releaseClassMatcher(JNIEnv*, jclass, jlong matcher){
+    delete reinterpret_cast<mikrom::ClassMatcher*>(matcher);
+}
+
+//整批过滤类名,返回命中白名单(句柄为0时不限制)且不命中黑名单的下标
+static jintArray DexFile_filterClassNames(JNIEnv* env, jclass, jlong white, jlong black, jobjectArray names){
+    if(names==nullptr){
+        return nullptr;
+    }
+    const mikrom::ClassMatcher* white_matcher=reinterpret_cast<const mikrom::ClassMatcher*>(white);
+    const mikrom::ClassMatcher* black_matcher=reinterpret_cast<const mikrom::ClassMatcher*>(black);
+    std::vector<jint> kept;
+    jsize count=env->GetArrayLength(names);
+    for(jsize i=0;i<count;i++){
+        ScopedLocalRef<jstring> name(env,(jstring)env->GetObjectArrayElement(names,i));
+        NullableScopedUtfChars chars(env,name.get());
+        if(chars.c_str()!=nullptr &&
+           mikrom::ClassAllowed(white_matcher,black_matcher,chars.c_str(),strlen(chars.c_str()))){
+            kept.push_back(i);
+        }
+    }
+    jintArray result=env->NewIntArray(kept.size());
+    if(result!=nullptr){
+        env->SetIntArrayRegion(result,0,kept.size(),kept.data());
+    }
+    return result;
+}
+
+//mmap读取whitePath类名列表,每行一个类名,Lcom/a/B;格式转成com.a.B,忽略少于2个字符的行
+static jobjectArray DexFile_readClassListFile(JNIEnv* env, jclass, jint fd){
+    struct stat st;
+    if(fd<0 || fstat(fd,&st)!=0){
+        return nullptr;
+    }
+    std::vector<std::string> classes;
+    if(st.st_size>0){
+        void* map=mmap(nullptr,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+        if(map==MAP_FAILED){
+            PLOG(ERROR)<<"mikrom readClassListFile mmap";
+            return nullptr;
+        }
+        const char* data=reinterpret_cast<const char*>(map);
+        const char* end=data+st.st_size;
+        while(data<end){
+            const char* line_end=reinterpret_cast<const char*>(memchr(data,'\n',end-data));
+            if(line_end==nullptr){
+                line_end=end;
+            }
+            size_t length=line_end-data;
+            if(length>0 && data[length-1]=='\r'){
+                --length;
+            }
+            if(length>=2){
+                if(data[0]=='L' && data[length-1]==';'){
+                    std::string name(data+1,length-2);
+                    std::replace(name.begin(),name.end(),'/','.');
+                    classes.push_back(std::move(name));
+                }else{
+                    classes.emplace_back(data,length);
+                }
+            }
+            data=line_end+1;
+        }
+        munmap(map,st.st_size);
+    }
+    ScopedLocalRef<jclass> string_class(env,env->FindClass("java/lang/String"));
+    jobjectArray result=env->NewObjectArray(classes.size(),string_class.get(),nullptr);
+    if(result==nullptr){
+        return nullptr;
+    }
+    for(size_t i=0;i<classes.size();i++){
+        ScopedLocalRef<jstring> name(env,env->NewStringUTF(classes[i].c_str()));
+        if(name.get()==nullptr){
+            return nullptr;
+        }
+        env->SetObjectArrayElement(result,i,name.get());
+    }
+    return result;
+}
+
+//cookie里所有dex的class_def总数,按dex顺序连续编号,给getFilteredClassNames分段用
+static jint DexFile_getClassDefCount(JNIEnv* env, jclass, jobject cookie){
+    const OatFile* oat_file=nullptr;
+    std::vector<const DexFile*> dex_files;
+    if(!ConvertJavaArrayToDexFiles(env,cookie,dex_files,oat_file)){
+        DCHECK(env->ExceptionCheck());
+        return 0;
+    }
+    size_t count=0;
+    for(const DexFile* dex_file : dex_files){
+        count+=dex_file->NumClassDefs();
+    }
+    return static_cast<jint>(count);
+}
+
+//cookie中每个类描述符第一次出现在第几个dex,分段取类名时用来跳过前面dex已经定义的类。
+//每个cookie只建一次,描述符直接指向dex数据,句柄释放前cookie不能关闭
+struct ClassDefIndex{
+    std::unordered_map<std::string_view,uint32_t> first_dex;
+};
+
+static jlong DexFile_indexClassDefs(JNIEnv* env, jclass, jobject cookie){
+    const OatFile* oat_file=nullptr;
+    std::vector<const DexFile*> dex_files;
+    if(!ConvertJavaArrayToDexFiles(env,cookie,dex_files,oat_file)){
+        DCHECK(env->ExceptionCheck());
+        return 0;
+    }
+    if(dex_files.size()<2){
+        return 0;
+    }
+    ClassDefIndex* index=new ClassDefIndex();
+    size_t total=0;
+    for(const DexFile* dex_file : dex_files){
+        total+=dex_file->NumClassDefs();
+    }
+    index->first_dex.reserve(total);
+    for(size_t d=0;d<dex_files.size();d++){
+        const DexFile* dex_file=dex_files[d];
+        for(size_t i=0;i<dex_file->NumClassDefs();i++){
+            index->first_dex.emplace(dex_file->GetClassDescriptor(dex_file->GetClassDef(i)),d);
+        }
+    }
+    return reinterpret_cast<jlong>(index);
+}
+
+static void DexFile_releaseClassDefIndex(JNIEnv*, jclass, jlong index){
+    delete reinterpret_cast<ClassDefIndex*>(index);
+}
+
+//getClassNameList的分段版本:只处理编号[start,start+count)的class_def,
+//描述符转换到复用的缓冲区里做白名单黑名单匹配,只为保留下来的类创建String。
+//前面的dex已经定义过的类按indexClassDefs的结果跳过,与getClassNameList去重的结果一致,
+//句柄为0(只有一个dex)时不去重
+static jobjectArray DexFile_getFilteredClassNames(JNIEnv* env, jclass, jobject cookie,
+                                                  jlong white, jlong black, jlong class_defs,
+                                                  jint start, jint count){
+    const OatFile* oat_file=nullptr;
+    std::vector<const DexFile*> dex_files;
+    if(!ConvertJavaArrayToDexFiles(env,cookie,dex_files,oat_file)){
+        DCHECK(env->ExceptionCheck());
+        return nullptr;
+    }
+    const mikrom::ClassMatcher* white_matcher=reinterpret_cast<const mikrom::ClassMatcher*>(white);
+    const mikrom::ClassMatcher* black_matcher=reinterpret_cast<const mikrom::ClassMatcher*>(black);
+    const ClassDefIndex* index=reinterpret_cast<const ClassDefIndex*>(class_defs);
+    std::vector<const char*> kept;
+    std::string name;
+    size_t begin=start>0?static_cast<size_t>(start):0;
+    size_t end=begin+(count>0?static_cast<size_t>(count):0);
+    size_t base=0;
+    for(size_t d=0;d<dex_files.size() && base<end;d++){
+        const DexFile* dex_file=dex_files[d];
+        size_t num=dex_file->NumClassDefs();
+        size_t first=std::min(num,std::max(begin,base)-base);
+        size_t last=std::min(end,base+num)-base;
+        for(size_t i=first;i<last;i++){
+            const char* descriptor=dex_file->GetClassDescriptor(dex_file->GetClassDef(i));
+            size_t length=strlen(descriptor);
+            if(length<2 || descriptor[0]!='L' || descriptor[length-1]!=';'){
+                continue;
+            }
+            name.assign(descriptor+1,length-2);
+            std::replace(name.begin(),name.end(),'/','.');
+            if(!mikrom::ClassAllowed(white_matcher,black_matcher,name.data(),name.size())){
+                continue;
+            }
+            if(d>0 && index!=nullptr){
+                auto it=index->first_dex.find(std::string_view(descriptor,length));
+                if(it!=index->first_dex.end() && it->second<d){
+                    continue;
+                }
+            }
+            kept.push_back(descriptor);
+        }
+        base+=num;
+    }
+    jobjectArray result=env->NewObjectArray(kept.size(),WellKnownClasses::java_lang_String,nullptr);
+    if(result==nullptr){
+        return nullptr;
+    }
+    for(size_t i=0;i<kept.size();i++){
+        std::string dot(DescriptorToDot(kept[i]));
+        ScopedLocalRef<jstring> jname(env,env->NewStringUTF(dot.c_str()));
+        if(jname.get()==nullptr){
+            return nullptr;
+        }
+        env->SetObjectArrayElement(result,i,jname.get());
+    }
+    return result;
+}
+
 static jint GetDexOptNeeded(JNIEnv* env,
                             const char* filename,
                             const char* instruction_set,
@@ -985,6 +1254,18 @@ static JNINativeMethod gMethods[] = {
   NATIVE_METHOD(DexFile, fartextMethodCode,"(Ljava/lang/Object;)V"),
   NATIVE_METHOD(DexFile, dumpRepair,"()V"),
   NATIVE_METHOD(DexFile, setMikRomConfig,"(Ljava/lang/Object;)Z"),
+  NATIVE_METHOD(DexFile, loadMikRomConfig,"([B)Z"),
+  NATIVE_METHOD(DexFile, dumpJniProfile,"()V"),
+  NATIVE_METHOD(DexFile, releaseDebugGate,"()V"),
+  NATIVE_METHOD(DexFile, dumpNativeRegistry,"()Z"),
+  NATIVE_METHOD(DexFile, compileClassMatcher,"([Ljava/lang/String;)J"),
+  NATIVE_METHOD(DexFile, releaseClassMatcher,"(J)V"),
+  NATIVE_METHOD(DexFile, filterClassNames,"(JJ[Ljava/lang/String;)[I"),
+  NATIVE_METHOD(DexFile, readClassListFile,"(I)[Ljava/lang/String;"),
+  NATIVE_METHOD(DexFile, getClassDefCount,"(Ljava/lang/Object;)I"),
+  NATIVE_METHOD(DexFile, indexClassDefs,"(Ljava/lang/Object;)J"),
+  NATIVE_METHOD(DexFile, releaseClassDefIndex,"(J)V"),
+  NATIVE_METHOD(DexFile, getFilteredClassNames,"(Ljava/lang/Object;JJJII)[Ljava/lang/String;"),
 
   //add end
 };
@@ -26,6 +26,7 @@
 #include "jni/java_vm_ext.h"
 #include "jni/jni_internal.h"
 #include "jvalue-inl.h"
+#include "mikrom/invoke_graph.h"
 #include "mirror/class-inl.h"
 #include "mirror/executable.h"
 #include "mirror/object_array-inl.h"
@@ -35,7 +36,6 @@
 #include "stack_reference.h"
 #include "thread-inl.h"
 #include "well_known_classes.h"
-#include <sstream>
 
 namespace art {
 namespace {
@@ -181,100 +181,6 @@ class ArgArray {
     }
   }
 
-  void VarArgsShowArg(const ScopedObjectAccessAlreadyRunnable& soa,
-                                  va_list ap,const char* jniMethodName,const char* methodName)
-        REQUIRES_SHARED(Locks::mutator_lock_) {
-      std::stringstream ss;
-		  ss << "mikrom jni "<<jniMethodName<<"\t"<<methodName<<"\t";
-      for (size_t i = 1; i < shorty_len_; ++i) {
-        switch (shorty_[i]) {
-          case 'Z':
-          case 'B':
-          case 'C':
-          case 'S':
-          case 'I':
-            ss<<"arg"<<i<<":"<<va_arg(ap, jint)<<"\t";
-            break;
-          case 'F':
-          	ss<<"arg"<<i<<":"<<va_arg(ap, jdouble)<<"\t";
-            break;
-          case 'L':{
-          	jobject obj=va_arg(ap, jobject);
-						ObjPtr<mirror::Object> receiver =soa.Decode<mirror::Object>(obj);
-						if(receiver==nullptr){
-							LOG(ERROR)<<"mikrom  "<<jniMethodName<<" receiver =nullptr";
-							break;
-						}
-						ObjPtr<mirror::Class> cls=receiver->GetClass();
-						if (cls->DescriptorEquals("Ljava/lang/String;")){
-								ObjPtr<mirror::String> argStr =soa.Decode<mirror::String>(obj);
-								ss<<"arg"<<i<<":"<<(const char*)argStr->GetValue();
-						}else{
-								ss<<"arg"<<i<<":"<<receiver<<"\t";
-						}
-						break;
-          }
-          case 'D':
-            ss<<"arg"<<i<<":"<<va_arg(ap, jdouble)<<"\t";
-            break;
-          case 'J':
-            ss<<"arg"<<i<<":"<<va_arg(ap, jlong)<<"\t";
-            break;
-        }
-      }
-      LOG(ERROR) << ss.str();
-    }
-
-    void JValuesShowArg(const ScopedObjectAccessAlreadyRunnable& soa,
-                                  const jvalue* args,const char * jniMethodName,const char* methodName)
-        REQUIRES_SHARED(Locks::mutator_lock_) {
-      std::stringstream ss;
-      ss << "mikrom jni "<<jniMethodName<<"\t"<<methodName<<"\t";
-      for (size_t i = 1, args_offset = 0; i < shorty_len_; ++i, ++args_offset) {
-        switch (shorty_[i]) {
-          case 'Z':
-            ss<<"arg"<<i<<":"<<args[args_offset].z<<"\t";
-            break;
-          case 'B':
-            ss<<"arg"<<i<<":"<<args[args_offset].b<<"\t";
-            break;
-          case 'C':
-            ss<<"arg"<<i<<":"<<args[args_offset].c<<"\t";
-            break;
-          case 'S':
-            ss<<"arg"<<i<<":"<<args[args_offset].s<<"\t";
-            break;
-          case 'I':
-            FALLTHROUGH_INTENDED;
-          case 'F':
-            ss<<"arg"<<i<<":"<<args[args_offset].i<<"\t";
-            break;
-          case 'L':{
-          	jobject obj=args[args_offset].l;
-						ObjPtr<mirror::Object> receiver =soa.Decode<mirror::Object>(obj);
-						if(receiver==nullptr){
-							LOG(ERROR)<<"mikrom  "<<jniMethodName<<" receiver =nullptr";
-							break;
-						}
-						ObjPtr<mirror::Class> cls=receiver->GetClass();
-						if (cls->DescriptorEquals("Ljava/lang/String;")){
-								ObjPtr<mirror::String> argStr =soa.Decode<mirror::String>(obj);
-								ss<<"arg"<<i<<":"<<(const char*)argStr->GetValue();
-						}else{
-								ss<<"arg"<<i<<":"<<receiver<<"\t";
-						}
-						break;
-          }
-          case 'D':
-            FALLTHROUGH_INTENDED;
-          case 'J':
-            ss<<"arg"<<i<<":"<<args[args_offset].j<<"\t";
-            break;
-        }
-      }
-      LOG(ERROR) << ss.str();
-    }
-
   void BuildArgArrayFromFrame(ShadowFrame* shadow_frame, uint32_t arg_offset)
       REQUIRES_SHARED(Locks::mutator_lock_) {
     // Set receiver if non-null (method is not static)
@@ -551,21 +457,8 @@ void InvokeWithArgArray(const ScopedObjectAccessAlreadyRunnable& soa,
     CheckMethodArguments(soa.Vm(), method->GetInterfaceMethodIfProxy(kRuntimePointerSize), args);
   }
   if(ArtMethod::IsInvokePrint()){
-		ArtMethod* artMethod= nullptr;
-		Thread* self=Thread::Current();
-		const ManagedStack* managedStack= self->GetManagedStack();
-		if(managedStack!= nullptr){
-				ArtMethod** tmpartmethod= managedStack->GetTopQuickFrame();
-				if(tmpartmethod!= nullptr){
-						artMethod=*tmpartmethod;
-				}
-		}
-		if(artMethod!= nullptr) {
-				std::ostringstream oss;
-				oss << "mikrom [InvokeWithArgArray]beforecall caller:" << artMethod->PrettyMethod() << "---called:"<< method->PrettyMethod();
-				LOG(ERROR)<<oss.str();
-		}
-	}
+    mikrom::InvokeGraph::Record(soa.Self(), method);
+  }
   method->Invoke(soa.Self(), args, arg_array->GetNumBytes(), result, shorty);
 }
 
@@ -693,58 +586,6 @@ JValue InvokeWithJValues(const ScopedObjectAccessAlreadyRunnable& soa, jobject o
   return result;
 }
 
-void ShowVarArgs(const ScopedObjectAccessAlreadyRunnable& soa,
-                                           const char* jniMethod,
-                                           jmethodID mid,
-                                           va_list args){
-	 if(ArtMethod::IsJNIMethodPrint()){
-	 			ArtMethod* method = jni::DecodeArtMethod(mid);
-   			uint32_t shorty_len = 0;
-         const char* shorty =
-               method->GetInterfaceMethodIfProxy(kRuntimePointerSize)->GetShorty(&shorty_len);
-         JValue result;
-         ArgArray arg_array(shorty, shorty_len);
-         arg_array.VarArgsShowArg(soa, args,jniMethod,method->PrettyMethod().c_str());
-	 }
-}
-void ShowJValue(const ScopedObjectAccessAlreadyRunnable& soa,
-                                           const char* jniMethod,
-                                           jmethodID mid,
-                                           const jvalue* args){
-    if(ArtMethod::IsJNIMethodPrint()){
-				ArtMethod* method = jni::DecodeArtMethod(mid);
-				uint32_t shorty_len = 0;
-				const char* shorty =
-						method->GetInterfaceMethodIfProxy(kRuntimePointerSize)->GetShorty(&shorty_len);
-				JValue result;
-				ArgArray arg_array(shorty, shorty_len);
-				arg_array.JValuesShowArg(soa, args,jniMethod,method->PrettyMethod().c_str());
-    }
-}
-
-void ShowJniField(const char* jniMethodName,jfieldID field) {
-		if(ArtMethod::IsJNIMethodPrint()){
-			ArtField* f = jni::DecodeArtField(field);
-			std::ostringstream oss;
-			oss << "mikrom jni "<<jniMethodName<<"\t"<<ArtField::PrettyField(f);
-			LOG(ERROR)<<oss.str();
-		}
-  }
-
-void ShowArgStr(const char* jniMethod,const char* str1,const char* str2){
-	if(ArtMethod::IsJNIMethodPrint()){
-			std::ostringstream oss;
-			if(str1!=nullptr && str2!=nullptr){
-				oss << "mikrom jni "<<jniMethod<<"\t"<<str1<<"\t"<<str2;
-			}else if(str1!=nullptr ){
-				oss << "mikrom jni "<<jniMethod<<"\t"<<str1;
-			}else{
-				oss << "mikrom jni "<<jniMethod;
-			}
-			LOG(ERROR)<<oss.str();
-  }
-}
-
 JValue InvokeVirtualOrInterfaceWithJValues(const ScopedObjectAccessAlreadyRunnable& soa,
                                            jobject obj, jmethodID mid, const jvalue* args) {
   // We want to make sure that the stack is not within a small distance from the
@@ -84,24 +84,6 @@ JValue InvokeVirtualOrInterfaceWithVarArgs(const ScopedObjectAccessAlreadyRunnab
                                            va_list args)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
-void ShowVarArgs(const ScopedObjectAccessAlreadyRunnable& soa,
-                                           const char* jniMethod,
-                                           jmethodID mid,
-                                           va_list args)
-    REQUIRES_SHARED(Locks::mutator_lock_);
-
-void ShowJValue(const ScopedObjectAccessAlreadyRunnable& soa,
-                                           const char* jniMethod,
-                                           jmethodID mid,
-                                           const jvalue* args)
-    REQUIRES_SHARED(Locks::mutator_lock_);
-
-void ShowArgStr(const char* jniMethod,const char* str1,const char* str2)
-    REQUIRES_SHARED(Locks::mutator_lock_);
-
-void ShowJniField(const char* jniMethodName,jfieldID field)
-		REQUIRES_SHARED(Locks::mutator_lock_);
-
 // num_frames is number of frames we look up for access check.
 jobject InvokeMethod(const ScopedObjectAccessAlreadyRunnable& soa,
                      jobject method,
@@ -0,0 +1,228 @@
+// change mikrom
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <android-base/stringprintf.h>
+#include <android-base/strings.h>
+
+#include "dex/dex_file.h"
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+namespace {
+
+struct Frame {
+  uint32_t method_id;
+  uint64_t start_ns;
+  uint64_t child_ns;
+  std::string stack;  // Folded stack up to and including this frame.
+};
+
+struct ThreadCalls {
+  std::vector<Frame> frames;
+  uint64_t last_ns = 0;
+};
+
+class CallsConverter {
+ public:
+  CallsConverter(uint64_t start_ns, uint32_t pid, FILE* chrome)
+      : start_ns_(start_ns), pid_(pid), chrome_(chrome) {}
+
+  void SetName(uint32_t method_id, const std::string& name) {
+    names_[method_id] = name;
+  }
+
+  void Enter(uint32_t tid, uint32_t method_id, uint64_t time_ns) {
+    ThreadCalls& thread = threads_[tid];
+    thread.last_ns = time_ns;
+    Frame frame;
+    frame.method_id = method_id;
+    frame.start_ns = time_ns;
+    frame.child_ns = 0;
+    frame.stack = thread.frames.empty() ? StringPrintf("thread-%u", tid) : thread.frames.back().stack;
+    frame.stack += ";";
+    frame.stack += Name(method_id);
+    thread.frames.push_back(std::move(frame));
+  }
+
+  void Exit(uint32_t tid, uint32_t method_id, uint64_t time_ns) {
+    ThreadCalls& thread = threads_[tid];
+    thread.last_ns = time_ns;
+    // Exits of frames whose events were dropped are implied by an outer exit.
+    size_t depth = thread.frames.size();
+    while (depth > 0 && thread.frames[depth - 1].method_id != method_id) {
+      --depth;
+    }
+    if (depth == 0) {
+      return;
+    }
+    while (thread.frames.size() >= depth) {
+      Pop(tid, &thread, time_ns);
+    }
+  }
+
+  // Closes the frames still open when the trace ended.
+  void Finish() {
+    for (auto& entry : threads_) {
+      while (!entry.second.frames.empty()) {
+        Pop(entry.first, &entry.second, entry.second.last_ns);
+      }
+    }
+  }
+
+  void WriteFolded(FILE* out) const {
+    for (const auto& entry : folded_ns_) {
+      // flamegraph.pl wants integer weights, use microseconds.
+      fprintf(out, "%s %llu\n",
+              entry.first.c_str(),
+              static_cast<unsigned long long>(entry.second / 1000));
+    }
+  }
+
+ private:
+  const std::string& Name(uint32_t method_id) {
+    std::string& name = names_[method_id];
+    if (name.empty()) {
+      name = StringPrintf("method#%u", method_id);
+    }
+    return name;
+  }
+
+  void Pop(uint32_t tid, ThreadCalls* thread, uint64_t time_ns) {
+    Frame& frame = thread->frames.back();
+    uint64_t total = time_ns > frame.start_ns ? time_ns - frame.start_ns : 0;
+    uint64_t self = total > frame.child_ns ? total - frame.child_ns : 0;
+    folded_ns_[frame.stack] += self;
+    if (chrome_ != nullptr) {
+      fprintf(chrome_,
+              "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+              first_event_ ? "\n" : ",\n",
+              JsonEscape(Name(frame.method_id)).c_str(),
+              pid_,
+              tid,
+              (frame.start_ns - start_ns_) / 1000.0,
+              total / 1000.0);
+      first_event_ = false;
+    }
+    thread->frames.pop_back();
+    if (!thread->frames.empty()) {
+      thread->frames.back().child_ns += total;
+    }
+  }
+
+  static std::string JsonEscape(const std::string& in) {
+    std::string out;
+    for (char c : in) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+      }
+      out += c;
+    }
+    return out;
+  }
+
+  const uint64_t start_ns_;
+  const uint32_t pid_;
+  FILE* const chrome_;
+  bool first_event_ = true;
+  std::unordered_map<uint32_t, std::string> names_;
+  std::map<uint32_t, ThreadCalls> threads_;
+  std::map<std::string, uint64_t> folded_ns_;
+};
+
+static FILE* OpenOutput(const std::string& path) {
+  FILE* out = fopen(path.c_str(), "w");
+  if (out == nullptr) {
+    fprintf(stderr, "Could not open %s: %s\n", path.c_str(), strerror(errno));
+  }
+  return out;
+}
+
+}  // namespace
+
+// Converts the entry/exit events of traceMode 3 into folded stacks (self time in
+// microseconds, for flamegraph.pl) and optionally a Chrome trace JSON.
+//   --folded=<file>  folded stacks, default stdout
+//   --chrome=<file>  trace for chrome://tracing or Perfetto
+int CallsCommand(CommandArgs& args) {
+  std::string folded_path;
+  std::string chrome_path;
+  for (const std::string& arg : args.extra) {
+    if (android::base::StartsWith(arg, "--folded=")) {
+      folded_path = arg.substr(strlen("--folded="));
+    } else if (android::base::StartsWith(arg, "--chrome=")) {
+      chrome_path = arg.substr(strlen("--chrome="));
+    } else {
+      fprintf(stderr, "Unknown option %s\n", arg.c_str());
+      return 1;
+    }
+  }
+
+  FILE* chrome = nullptr;
+  if (!chrome_path.empty()) {
+    chrome = OpenOutput(chrome_path);
+    if (chrome == nullptr) {
+      return 1;
+    }
+    fprintf(chrome, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  }
+  CallsConverter converter(args.trace.Header().start_ns, args.trace.Header().pid, chrome);
+
+  args.trace.ForEachRecord([&](uint32_t, const RecordHeader* header) {
+    if (header->type != kRecordMethod) {
+      return;
+    }
+    MethodRecord record;
+    memcpy(&record, header, sizeof(record));
+    const DexFile* dex_file = args.dex_set.Find(record.dex_checksum);
+    converter.SetName(record.method_id,
+                      dex_file != nullptr
+                          ? dex_file->PrettyMethod(record.method_idx)
+                          : StringPrintf("<dex %08x>.method@%u",
+                                         record.dex_checksum,
+                                         record.method_idx));
+  });
+  args.trace.ForEachRecord([&](uint32_t tid, const RecordHeader* header) {
+    if (header->type != kRecordMethodEnter &&
+        header->type != kRecordMethodExit &&
+        header->type != kRecordMethodUnwind) {
+      return;
+    }
+    CallRecord record;
+    memcpy(&record, header, sizeof(record));
+    if (header->type == kRecordMethodEnter) {
+      converter.Enter(tid, record.method_id, record.time_ns);
+    } else {
+      converter.Exit(tid, record.method_id, record.time_ns);
+    }
+  });
+  converter.Finish();
+
+  if (chrome != nullptr) {
+    fprintf(chrome, "\n]}\n");
+    fclose(chrome);
+  }
+  if (folded_path.empty()) {
+    converter.WriteFolded(stdout);
+  } else {
+    FILE* folded = OpenOutput(folded_path);
+    if (folded == nullptr) {
+      return 1;
+    }
+    converter.WriteFolded(folded);
+    fclose(folded);
+  }
+  return 0;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,224 @@
+// change mikrom
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <android-base/stringprintf.h>
+#include <android-base/strings.h>
+
+#include "dex/class_accessor-inl.h"
+#include "dex/code_item_accessors-inl.h"
+#include "dex/dex_file.h"
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+namespace {
+
+struct CoveredMethod {
+  std::string name;
+  uint32_t dex_checksum = 0;
+  uint32_t method_idx = 0;
+  uint32_t insns_size = 0;
+  const DexFile* dex_file = nullptr;
+  std::vector<uint32_t> block_start;
+  std::vector<uint32_t> bits;
+};
+
+// drcov basic block entry: offset from the module start, size in bytes, module id.
+struct DrcovBlock {
+  uint32_t start;
+  uint16_t size;
+  uint16_t module;
+};
+
+// Offset of the first instruction of every method of |dex_file| that has code.
+static std::unordered_map<uint32_t, uint32_t> InsnsOffsets(const DexFile& dex_file) {
+  std::unordered_map<uint32_t, uint32_t> offsets;
+  for (ClassAccessor accessor : dex_file.GetClasses()) {
+    for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+      CodeItemInstructionAccessor instructions = method.GetInstructions();
+      if (instructions.HasCodeItem()) {
+        offsets[method.GetIndex()] = static_cast<uint32_t>(
+            reinterpret_cast<const uint8_t*>(instructions.Insns()) - dex_file.Begin());
+      }
+    }
+  }
+  return offsets;
+}
+
+static bool IsHit(const CoveredMethod& method, size_t block) {
+  return block / 32 < method.bits.size() && (method.bits[block / 32] & (1u << (block % 32))) != 0;
+}
+
+static uint32_t BlockEnd(const CoveredMethod& method, size_t block) {
+  return block + 1 < method.block_start.size() ? method.block_start[block + 1] : method.insns_size;
+}
+
+static bool WriteDrcov(const std::string& path, const std::map<uint32_t, CoveredMethod>& methods) {
+  std::map<uint32_t, uint16_t> module_ids;  // dex checksum -> module id
+  std::vector<const CoveredMethod*> module_methods;
+  for (const auto& entry : methods) {
+    if (module_ids.find(entry.second.dex_checksum) == module_ids.end()) {
+      uint16_t id = static_cast<uint16_t>(module_ids.size());
+      module_ids[entry.second.dex_checksum] = id;
+      module_methods.push_back(&entry.second);
+    }
+  }
+  std::unordered_map<uint32_t, std::unordered_map<uint32_t, uint32_t>> offsets;
+  std::vector<DrcovBlock> blocks;
+  size_t unmapped = 0;
+  for (const auto& entry : methods) {
+    const CoveredMethod& method = entry.second;
+    if (method.dex_file == nullptr) {
+      ++unmapped;
+      continue;
+    }
+    auto dex_it = offsets.find(method.dex_checksum);
+    if (dex_it == offsets.end()) {
+      dex_it = offsets.emplace(method.dex_checksum, InsnsOffsets(*method.dex_file)).first;
+    }
+    auto insns_it = dex_it->second.find(method.method_idx);
+    if (insns_it == dex_it->second.end()) {
+      ++unmapped;
+      continue;
+    }
+    for (size_t i = 0; i < method.block_start.size(); ++i) {
+      if (!IsHit(method, i)) {
+        continue;
+      }
+      uint32_t size = (BlockEnd(method, i) - method.block_start[i]) * sizeof(uint16_t);
+      DrcovBlock block;
+      block.start = insns_it->second + method.block_start[i] * sizeof(uint16_t);
+      block.size = static_cast<uint16_t>(std::min<uint32_t>(size, UINT16_MAX));
+      block.module = module_ids[method.dex_checksum];
+      blocks.push_back(block);
+    }
+  }
+  if (unmapped != 0) {
+    fprintf(stderr, "Warning: %zu methods left out of %s, pass their dex with --dex\n",
+            unmapped, path.c_str());
+  }
+
+  FILE* out = fopen(path.c_str(), "wb");
+  if (out == nullptr) {
+    fprintf(stderr, "Could not open %s: %s\n", path.c_str(), strerror(errno));
+    return false;
+  }
+  fprintf(out, "DRCOV VERSION: 2\nDRCOV FLAVOR: mikrom\n");
+  fprintf(out, "Module Table: version 2, count %zu\n", module_methods.size());
+  fprintf(out, "Columns: id, base, end, entry, checksum, timestamp, path\n");
+  for (const CoveredMethod* method : module_methods) {
+    size_t size = method->dex_file != nullptr ? method->dex_file->Size() : 0;
+    std::string location = method->dex_file != nullptr
+        ? method->dex_file->GetLocation()
+        : StringPrintf("%08x_dexfile.dex", method->dex_checksum);
+    fprintf(out, " %u, 0x0, 0x%zx, 0x0, 0x%08x, 0x0, %s\n",
+            module_ids[method->dex_checksum], size, method->dex_checksum, location.c_str());
+  }
+  fprintf(out, "BB Table: %zu bbs\n", blocks.size());
+  fwrite(blocks.data(), sizeof(DrcovBlock), blocks.size(), out);
+  fclose(out);
+  return true;
+}
+
+}  // namespace
+
+// Prints the basic blocks hit per method; --drcov=<file> also exports them as a
+// drcov v2 file with one module per dex, usable by lighthouse/bncov style tools.
+int CoverageCommand(CommandArgs& args) {
+  std::string drcov_path;
+  for (const std::string& arg : args.extra) {
+    if (android::base::StartsWith(arg, "--drcov=")) {
+      drcov_path = arg.substr(strlen("--drcov="));
+    } else {
+      fprintf(stderr, "Unknown option %s\n", arg.c_str());
+      return 1;
+    }
+  }
+
+  std::map<uint32_t, CoveredMethod> methods;
+  args.trace.ForEachRecord([&](uint32_t, const RecordHeader* header) {
+    if (header->type == kRecordMethod) {
+      MethodRecord record;
+      memcpy(&record, header, sizeof(record));
+      CoveredMethod& method = methods[record.method_id];
+      method.dex_checksum = record.dex_checksum;
+      method.method_idx = record.method_idx;
+      method.insns_size = record.insns_size;
+      method.dex_file = args.dex_set.Find(record.dex_checksum);
+      if (method.dex_file != nullptr) {
+        method.name = method.dex_file->PrettyMethod(record.method_idx);
+      } else {
+        method.name = StringPrintf("<dex %08x>.method@%u", record.dex_checksum, record.method_idx);
+      }
+    } else if (header->type == kRecordBlocks) {
+      BlocksRecord record;
+      memcpy(&record, header, sizeof(record));
+      if (sizeof(record) + record.block_count * sizeof(uint32_t) > header->size) {
+        return;
+      }
+      std::vector<uint32_t>& block_start = methods[record.method_id].block_start;
+      block_start.resize(record.block_count);
+      memcpy(block_start.data(),
+             reinterpret_cast<const uint8_t*>(header) + sizeof(record),
+             record.block_count * sizeof(uint32_t));
+    } else if (header->type == kRecordCoverage) {
+      CoverageRecord record;
+      memcpy(&record, header, sizeof(record));
+      size_t words = (record.block_count + 31) / 32;
+      if (sizeof(record) + words * sizeof(uint32_t) > header->size) {
+        return;
+      }
+      // Snapshots only ever add bits, but merging keeps the result right no
+      // matter how the chunks of different threads were interleaved.
+      std::vector<uint32_t>& bits = methods[record.method_id].bits;
+      bits.resize(std::max(bits.size(), words));
+      const uint8_t* data = reinterpret_cast<const uint8_t*>(header) + sizeof(record);
+      for (size_t i = 0; i < words; ++i) {
+        uint32_t word;
+        memcpy(&word, data + i * sizeof(uint32_t), sizeof(word));
+        bits[i] |= word;
+      }
+    }
+  });
+
+  size_t total_blocks = 0;
+  size_t total_hit = 0;
+  for (const auto& entry : methods) {
+    const CoveredMethod& method = entry.second;
+    if (method.block_start.empty()) {
+      continue;
+    }
+    size_t hit = 0;
+    for (size_t i = 0; i < method.block_start.size(); ++i) {
+      hit += IsHit(method, i) ? 1 : 0;
+    }
+    total_blocks += method.block_start.size();
+    total_hit += hit;
+    printf("%s %zu/%zu blocks\n", method.name.c_str(), hit, method.block_start.size());
+    for (size_t i = 0; i < method.block_start.size(); ++i) {
+      printf("  %c 0x%04x-0x%04x\n",
+             IsHit(method, i) ? '+' : '-',
+             method.block_start[i],
+             BlockEnd(method, i));
+    }
+  }
+  printf("total %zu/%zu blocks in %zu methods\n", total_hit, total_blocks, methods.size());
+
+  if (!drcov_path.empty() && !WriteDrcov(drcov_path, methods)) {
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,49 @@
+// change mikrom
+#include "dex_set.h"
+
+#include <android-base/file.h>
+
+#include "dex/dex_file.h"
+#include "dex/dex_file_loader.h"
+
+namespace art {
+namespace mikrom {
+
+DexSet::DexSet() {}
+
+DexSet::~DexSet() {}
+
+bool DexSet::Add(const std::string& path, std::string* error_msg) {
+  std::unique_ptr<std::string> content(new std::string());
+  if (!android::base::ReadFileToString(path, content.get())) {
+    *error_msg = "Failed to read " + path;
+    return false;
+  }
+  const DexFileLoader dex_file_loader;
+  DexFileLoaderErrorCode error_code;
+  std::vector<std::unique_ptr<const DexFile>> dex_files;
+  if (!dex_file_loader.OpenAll(reinterpret_cast<const uint8_t*>(content->data()),
+                               content->size(),
+                               path,
+                               /* verify= */ false,
+                               /* verify_checksum= */ false,
+                               &error_code,
+                               error_msg,
+                               &dex_files)) {
+    return false;
+  }
+  for (std::unique_ptr<const DexFile>& dex_file : dex_files) {
+    by_checksum_.emplace(dex_file->GetHeader().checksum_, dex_file.get());
+    dex_files_.push_back(std::move(dex_file));
+  }
+  contents_.push_back(std::move(content));
+  return true;
+}
+
+const DexFile* DexSet::Find(uint32_t checksum) const {
+  auto it = by_checksum_.find(checksum);
+  return it != by_checksum_.end() ? it->second : nullptr;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,37 @@
+// change mikrom
+#ifndef ART_TOOLS_MIKROM_DEX_SET_H_
+#define ART_TOOLS_MIKROM_DEX_SET_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace art {
+
+class DexFile;
+
+namespace mikrom {
+
+// Dex files given on the command line (.dex, .apk or dumped *_dexfile.dex),
+// looked up by the header checksum that the runtime stores in its records.
+class DexSet {
+ public:
+  DexSet();
+  ~DexSet();
+
+  bool Add(const std::string& path, std::string* error_msg);
+  const DexFile* Find(uint32_t checksum) const;
+
+ private:
+  std::vector<std::unique_ptr<std::string>> contents_;
+  std::vector<std::unique_ptr<const DexFile>> dex_files_;
+  std::map<uint32_t, const DexFile*> by_checksum_;
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_TOOLS_MIKROM_DEX_SET_H_
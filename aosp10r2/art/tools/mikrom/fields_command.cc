@@ -0,0 +1,118 @@
+// change mikrom
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+
+#include <android-base/stringprintf.h>
+
+#include "dex/dex_file.h"
+#include "dex/primitive.h"
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+namespace {
+
+static std::string FormatValue(const FieldRecord& record, const char* string_data) {
+  switch (static_cast<Primitive::Type>(record.type)) {
+    case Primitive::kPrimBoolean:
+      return record.value != 0 ? "true" : "false";
+    case Primitive::kPrimByte:
+      return StringPrintf("%d", static_cast<int8_t>(record.value));
+    case Primitive::kPrimChar:
+      return StringPrintf("'\\u%04x'", static_cast<uint16_t>(record.value));
+    case Primitive::kPrimShort:
+      return StringPrintf("%d", static_cast<int16_t>(record.value));
+    case Primitive::kPrimInt:
+      return StringPrintf("%d (0x%x)", static_cast<int32_t>(record.value),
+                          static_cast<uint32_t>(record.value));
+    case Primitive::kPrimLong:
+      return StringPrintf("%" PRId64 " (0x%" PRIx64 ")", static_cast<int64_t>(record.value),
+                          record.value);
+    case Primitive::kPrimFloat: {
+      float f;
+      uint32_t bits = static_cast<uint32_t>(record.value);
+      memcpy(&f, &bits, sizeof(f));
+      return StringPrintf("%g", f);
+    }
+    case Primitive::kPrimDouble: {
+      double d;
+      memcpy(&d, &record.value, sizeof(d));
+      return StringPrintf("%g", d);
+    }
+    case Primitive::kPrimNot:
+      if (record.value == 0) {
+        return "null";
+      }
+      if (string_data != nullptr) {
+        return StringPrintf("\"%.*s\" @%08x",
+                            static_cast<int>(record.string_length),
+                            string_data,
+                            static_cast<uint32_t>(record.value));
+      }
+      return StringPrintf("@%08x", static_cast<uint32_t>(record.value));
+    default:
+      return StringPrintf("0x%" PRIx64, record.value);
+  }
+}
+
+}  // namespace
+
+// Prints the field reads and writes of traceMode 4 in execution order per thread.
+int FieldsCommand(CommandArgs& args) {
+  std::unordered_map<uint32_t, std::string> method_names;
+  args.trace.ForEachRecord([&](uint32_t, const RecordHeader* header) {
+    if (header->type != kRecordMethod) {
+      return;
+    }
+    MethodRecord record;
+    memcpy(&record, header, sizeof(record));
+    const DexFile* dex_file = args.dex_set.Find(record.dex_checksum);
+    method_names[record.method_id] = dex_file != nullptr
+        ? dex_file->PrettyMethod(record.method_idx)
+        : StringPrintf("<dex %08x>.method@%u", record.dex_checksum, record.method_idx);
+  });
+
+  uint32_t last_tid = 0;
+  uint32_t last_method = 0;
+  args.trace.ForEachRecord([&](uint32_t tid, const RecordHeader* header) {
+    if (header->type != kRecordField) {
+      return;
+    }
+    FieldRecord record;
+    memcpy(&record, header, sizeof(record));
+    if (sizeof(record) + record.string_length > header->size) {
+      return;
+    }
+    if (tid != last_tid || record.method_id != last_method) {
+      printf("[%u] %s\n", tid, method_names[record.method_id].c_str());
+      last_tid = tid;
+      last_method = record.method_id;
+    }
+    const DexFile* dex_file = args.dex_set.Find(record.dex_checksum);
+    std::string field = dex_file != nullptr
+        ? dex_file->PrettyField(record.field_idx)
+        : StringPrintf("<dex %08x>.field@%u", record.dex_checksum, record.field_idx);
+    const char* string_data = record.string_length != 0
+        ? reinterpret_cast<const char*>(header) + sizeof(record)
+        : nullptr;
+    std::string receiver = record.object_id != 0 ? StringPrintf(" @%08x", record.object_id) : "";
+    printf("[%u] mikrom fieldTrace 0x%x: %s %s%s = %s\n",
+           tid,
+           record.dex_pc,
+           record.access == kFieldWrite ? "put" : "get",
+           field.c_str(),
+           receiver.c_str(),
+           FormatValue(record, string_data).c_str());
+  });
+  return 0;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,112 @@
+// change mikrom
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <android-base/strings.h>
+
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+namespace {
+
+struct Edge {
+  std::string caller;
+  std::string callee;
+  uint64_t count;
+};
+
+static std::string DotEscape(const std::string& in) {
+  std::string out;
+  for (char c : in) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out;
+}
+
+}  // namespace
+
+// Prints the caller -> callee edges counted through InvokeWithArgArray while
+// isInvokePrint is set (reflection and JNI Call*Method), most called first.
+//   --top=<n>     edges listed, default all
+//   --dot=<file>  also writes the listed edges as a Graphviz digraph
+int InvokesCommand(CommandArgs& args) {
+  size_t top = SIZE_MAX;
+  std::string dot_path;
+  for (const std::string& arg : args.extra) {
+    if (android::base::StartsWith(arg, "--top=")) {
+      top = strtoul(arg.c_str() + strlen("--top="), nullptr, 10);
+    } else if (android::base::StartsWith(arg, "--dot=")) {
+      dot_path = arg.substr(strlen("--dot="));
+    } else {
+      fprintf(stderr, "Unknown option %s\n", arg.c_str());
+      return 1;
+    }
+  }
+
+  JniStringTable strings = ReadJniStrings(args.trace);
+  // Snapshots are cumulative, the last one written for an edge wins.
+  std::map<uint32_t, InvokeEdgeRecord> records;
+  args.trace.ForEachRecord([&](uint32_t, const RecordHeader* header) {
+    if (header->type != kRecordInvokeEdge || header->size < sizeof(InvokeEdgeRecord)) {
+      return;
+    }
+    InvokeEdgeRecord record;
+    memcpy(&record, header, sizeof(record));
+    records[record.edge_id] = record;
+  });
+
+  std::vector<Edge> edges;
+  for (const auto& entry : records) {
+    const InvokeEdgeRecord& record = entry.second;
+    Edge edge;
+    edge.caller = record.caller_id != 0 ? strings[record.caller_id] : "<native>";
+    edge.callee = strings[record.callee_id];
+    edge.count = record.count;
+    edges.push_back(std::move(edge));
+  }
+  std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+    return a.count > b.count;
+  });
+  if (edges.size() > top) {
+    edges.resize(top);
+  }
+
+  for (const Edge& edge : edges) {
+    printf("%10llu  %s -> %s\n",
+           static_cast<unsigned long long>(edge.count),
+           edge.caller.c_str(),
+           edge.callee.c_str());
+  }
+  if (!dot_path.empty()) {
+    FILE* dot = fopen(dot_path.c_str(), "w");
+    if (dot == nullptr) {
+      fprintf(stderr, "Could not open %s: %s\n", dot_path.c_str(), strerror(errno));
+      return 1;
+    }
+    fprintf(dot, "digraph invokes {\n  node [shape=box];\n");
+    for (const Edge& edge : edges) {
+      fprintf(dot, "  \"%s\" -> \"%s\" [label=\"%llu\"];\n",
+              DotEscape(edge.caller).c_str(),
+              DotEscape(edge.callee).c_str(),
+              static_cast<unsigned long long>(edge.count));
+    }
+    fprintf(dot, "}\n");
+    fclose(dot);
+  }
+  return 0;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,127 @@
+// change mikrom
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <android-base/stringprintf.h>
+
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+namespace {
+
+static std::string FormatArg(const JniArg& arg, const JniStringTable& strings) {
+  switch (arg.type) {
+    case kJniArgNull:
+      return "null";
+    case kJniArgInt:
+    case kJniArgLong:
+      return StringPrintf("%" PRId64, static_cast<int64_t>(arg.value));
+    case kJniArgDouble: {
+      double d;
+      memcpy(&d, &arg.value, sizeof(d));
+      return StringPrintf("%g", d);
+    }
+    case kJniArgObject:
+      return StringPrintf("@%08x", static_cast<uint32_t>(arg.value));
+    case kJniArgString: {
+      auto it = strings.find(static_cast<uint32_t>(arg.value));
+      return it != strings.end() ? it->second : StringPrintf("<string#%" PRIu64 ">", arg.value);
+    }
+    default:
+      return StringPrintf("<type %u>", arg.type);
+  }
+}
+
+static std::string FormatCaller(const JniCallRecord& record, const JniStringTable& strings) {
+  if (record.caller_module == 0) {
+    return StringPrintf("0x%" PRIx64, record.caller_pc);
+  }
+  return StringPrintf("%s+0x%" PRIx64,
+                      JniModuleName(strings, record.caller_module).c_str(),
+                      record.caller_pc);
+}
+
+}  // namespace
+
+JniStringTable ReadJniStrings(const TraceReader& trace) {
+  JniStringTable strings;
+  trace.ForEachRecord([&](uint32_t, const RecordHeader* header) {
+    if (header->type != kRecordJniString) {
+      return;
+    }
+    JniStringRecord record;
+    memcpy(&record, header, sizeof(record));
+    if (sizeof(record) + record.length > header->size) {
+      return;
+    }
+    strings[record.string_id].assign(reinterpret_cast<const char*>(header) + sizeof(record),
+                                     record.length);
+  });
+  return strings;
+}
+
+std::string JniModuleName(const JniStringTable& strings, uint32_t module_id) {
+  auto it = strings.find(module_id);
+  if (module_id == 0 || it == strings.end()) {
+    return module_id == 0 ? "<unknown>" : StringPrintf("<module#%u>", module_id);
+  }
+  size_t slash = it->second.rfind('/');
+  return slash != std::string::npos ? it->second.substr(slash + 1) : it->second;
+}
+
+// Prints the JNI calls recorded while isJNIMethodPrint is set, one line per call in
+// the format the runtime used to log:
+//   mikrom jni <function>\t<method or field>\targ1:<value>\t...caller:<lib>+<offset>
+//   mikrom jni <function>\t<string>\t<string>\tcaller:<lib>+<offset>
+// The caller offset is relative to the load bias, as shown by disassemblers.
+int JniCommand(CommandArgs& args) {
+  JniStringTable strings = ReadJniStrings(args.trace);
+
+  std::vector<JniArg> call_args;
+  args.trace.ForEachRecord([&](uint32_t tid, const RecordHeader* header) {
+    if (header->type != kRecordJniCall) {
+      return;
+    }
+    JniCallRecord record;
+    memcpy(&record, header, sizeof(record));
+    if (sizeof(record) + static_cast<uint64_t>(record.arg_count) * sizeof(JniArg) > header->size) {
+      return;
+    }
+    call_args.resize(record.arg_count);
+    memcpy(call_args.data(),
+           reinterpret_cast<const uint8_t*>(header) + sizeof(record),
+           record.arg_count * sizeof(JniArg));
+
+    std::string line = StringPrintf("[%u] mikrom jni %s", tid, strings[record.function_id].c_str());
+    if (record.target_id != 0) {
+      line += "\t";
+      line += strings[record.target_id];
+      line += "\t";
+      for (uint32_t i = 0; i < record.arg_count; ++i) {
+        line += StringPrintf("arg%u:%s\t", i + 1, FormatArg(call_args[i], strings).c_str());
+      }
+    } else {
+      for (const JniArg& arg : call_args) {
+        line += "\t";
+        line += FormatArg(arg, strings);
+      }
+      line += "\t";
+    }
+    line += "caller:";
+    line += FormatCaller(record, strings);
+    printf("%s\n", line.c_str());
+  });
+  return 0;
+}
+
+}  // namespace mikrom
+}  // namespace art
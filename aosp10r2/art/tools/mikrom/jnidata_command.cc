@@ -0,0 +1,121 @@
+// change mikrom
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+#include <android-base/file.h>
+#include <android-base/stringprintf.h>
+#include <android-base/strings.h>
+
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+namespace {
+
+static void HexDump(const uint8_t* data, size_t size) {
+  for (size_t offset = 0; offset < size; offset += 16) {
+    std::string hex;
+    std::string ascii;
+    for (size_t i = offset; i < offset + 16; ++i) {
+      if (i < size) {
+        hex += StringPrintf("%02x ", data[i]);
+        ascii += (data[i] >= 0x20 && data[i] < 0x7f) ? static_cast<char>(data[i]) : '.';
+      } else {
+        hex += "   ";
+      }
+    }
+    printf("  %08zx  %s |%s|\n", offset, hex.c_str(), ascii.c_str());
+  }
+}
+
+}  // namespace
+
+// Prints the payloads captured with jniDataMaxBytes from the mikrom_<pid>.jnidata
+// side file, in order per thread, with a hex dump of each payload the first time
+// it is seen. The names come from the main trace.
+//   --data=<file>   the side file, required
+//   --bytes=<n>     bytes dumped per payload, default 256
+//   --out=<dir>     also writes every payload to <dir>/<content hash>.bin
+int JniDataCommand(CommandArgs& args) {
+  std::string data_path;
+  std::string out_dir;
+  size_t max_bytes = 256;
+  for (const std::string& arg : args.extra) {
+    if (android::base::StartsWith(arg, "--data=")) {
+      data_path = arg.substr(strlen("--data="));
+    } else if (android::base::StartsWith(arg, "--bytes=")) {
+      max_bytes = strtoul(arg.c_str() + strlen("--bytes="), nullptr, 10);
+    } else if (android::base::StartsWith(arg, "--out=")) {
+      out_dir = arg.substr(strlen("--out="));
+    } else {
+      fprintf(stderr, "Unknown option %s\n", arg.c_str());
+      return 1;
+    }
+  }
+  if (data_path.empty()) {
+    fprintf(stderr, "jnidata needs --data=<mikrom_<pid>.jnidata>\n");
+    return 1;
+  }
+  TraceReader data;
+  std::string error_msg;
+  if (!data.Open(data_path, &error_msg)) {
+    fprintf(stderr, "%s\n", error_msg.c_str());
+    return 1;
+  }
+  if (data.DroppedRecords() != 0) {
+    fprintf(stderr, "Warning: the device dropped %llu payloads\n",
+            static_cast<unsigned long long>(data.DroppedRecords()));
+  }
+
+  JniStringTable strings = ReadJniStrings(args.trace);
+  bool ok = true;
+  data.ForEachRecord([&](uint32_t tid, const RecordHeader* header) {
+    if (header->type != kRecordJniData) {
+      return;
+    }
+    JniDataRecord record;
+    memcpy(&record, header, sizeof(record));
+    if (sizeof(record) + record.length > header->size) {
+      return;
+    }
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(header) + sizeof(record);
+    std::string caller = record.caller_module != 0
+        ? StringPrintf("%s+0x%" PRIx64,
+                       JniModuleName(strings, record.caller_module).c_str(),
+                       record.caller_pc)
+        : StringPrintf("0x%" PRIx64, record.caller_pc);
+    printf("[%u] mikrom jnidata %s\tcaller:%s\tlen:%u/%u\thash:%016" PRIx64 "%s\n",
+           tid,
+           strings[record.function_id].c_str(),
+           caller.c_str(),
+           record.length,
+           record.total_length,
+           record.content_hash,
+           (record.flags & kJniDataDuplicate) != 0 ? "\tseen before" : "");
+    if (record.length == 0) {
+      return;
+    }
+    HexDump(payload, std::min<size_t>(record.length, max_bytes));
+    if (!out_dir.empty()) {
+      std::string path = StringPrintf("%s/%016" PRIx64 ".bin", out_dir.c_str(), record.content_hash);
+      std::string contents(reinterpret_cast<const char*>(payload), record.length);
+      if (!android::base::WriteStringToFile(contents, path)) {
+        fprintf(stderr, "Could not write %s: %s\n", path.c_str(), strerror(errno));
+        ok = false;
+      }
+    }
+  });
+  return ok ? 0 : 1;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,133 @@
+// change mikrom
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <android-base/stringprintf.h>
+#include <android-base/strings.h>
+
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+namespace {
+
+struct ProfileKey {
+  std::string caller;
+  std::string function;
+  std::string target;
+
+  bool operator<(const ProfileKey& other) const {
+    return std::tie(caller, function, target) <
+           std::tie(other.caller, other.function, other.target);
+  }
+};
+
+struct ProfileTotals {
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+  uint64_t latency[kJniLatencyBuckets] = {};
+};
+
+// Upper bound of the latency bucket holding the |fraction| quantile. Bucket i
+// holds latencies in [2^(i-1), 2^i) ns, bucket 0 holds zero.
+static uint64_t Quantile(const ProfileTotals& totals, double fraction) {
+  uint64_t samples = 0;
+  for (uint64_t count : totals.latency) {
+    samples += count;
+  }
+  uint64_t rank = static_cast<uint64_t>(samples * fraction);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kJniLatencyBuckets; ++i) {
+    seen += totals.latency[i];
+    if (seen > rank) {
+      return i == 0 ? 0 : UINT64_C(1) << i;
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+// Prints the call counts of jniTraceMode 1 per caller library, JNI function and
+// method or field, most called first, with latency quantiles rounded up to a
+// power of two. --top=<n> limits the rows printed.
+int JniProfileCommand(CommandArgs& args) {
+  size_t top = SIZE_MAX;
+  for (const std::string& arg : args.extra) {
+    if (android::base::StartsWith(arg, "--top=")) {
+      top = strtoul(arg.c_str() + strlen("--top="), nullptr, 10);
+    } else {
+      fprintf(stderr, "Unknown option %s\n", arg.c_str());
+      return 1;
+    }
+  }
+
+  JniStringTable strings = ReadJniStrings(args.trace);
+  // Snapshots are cumulative, the last one written for an entry wins.
+  std::map<uint32_t, JniProfileRecord> entries;
+  args.trace.ForEachRecord([&](uint32_t, const RecordHeader* header) {
+    if (header->type != kRecordJniProfile || header->size < sizeof(JniProfileRecord)) {
+      return;
+    }
+    JniProfileRecord record;
+    memcpy(&record, header, sizeof(record));
+    entries[record.entry_id] = record;
+  });
+
+  // Entries differing only by module load address end up in the same row.
+  std::map<ProfileKey, ProfileTotals> rows;
+  for (const auto& entry : entries) {
+    const JniProfileRecord& record = entry.second;
+    ProfileKey key;
+    key.caller = JniModuleName(strings, record.caller_module);
+    key.function = strings[record.function_id];
+    key.target = record.target_id != 0 ? strings[record.target_id] : "";
+    ProfileTotals& totals = rows[key];
+    totals.count += record.count;
+    totals.total_ns += record.total_ns;
+    for (size_t i = 0; i < kJniLatencyBuckets; ++i) {
+      totals.latency[i] += record.latency[i];
+    }
+  }
+
+  std::vector<std::pair<const ProfileKey*, const ProfileTotals*>> sorted;
+  for (const auto& row : rows) {
+    sorted.emplace_back(&row.first, &row.second);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return a.second->count > b.second->count;
+  });
+  if (sorted.size() > top) {
+    sorted.resize(top);
+  }
+
+  printf("%10s %10s %9s %9s %9s  caller\tfunction\ttarget\n",
+         "count", "total_ms", "avg_us", "p50_us", "p99_us");
+  for (const auto& row : sorted) {
+    const ProfileTotals& totals = *row.second;
+    double avg_us = totals.count != 0 ? totals.total_ns / 1000.0 / totals.count : 0.0;
+    printf("%10llu %10.3f %9.3f %9.3f %9.3f  %s\t%s\t%s\n",
+           static_cast<unsigned long long>(totals.count),
+           totals.total_ns / 1000000.0,
+           avg_us,
+           Quantile(totals, 0.5) / 1000.0,
+           Quantile(totals, 0.99) / 1000.0,
+           row.first->caller.c_str(),
+           row.first->function.c_str(),
+           row.first->target.c_str());
+  }
+  return 0;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,125 @@
+// change mikrom
+#include "mikromtrace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <android-base/strings.h>
+
+namespace art {
+namespace mikrom {
+
+static void Usage() {
+  fprintf(stderr,
+          "Usage: mikromtrace <command> [--dex=<file>]... <trace file>\n"
+          "Decodes /sdcard/Android/data/<package>/files/trace/mikrom_<pid>.trace\n"
+          "\n"
+          "Commands:\n"
+          "  smali     annotated smali listing of the traced methods\n"
+          "  coverage  basic blocks hit per method (traceMode 1)\n"
+          "            --drcov=<file> also writes them in drcov format\n"
+          "  profile   hottest instructions per method (traceMode 2)\n"
+          "            --top=<n> instructions listed per method, default 20\n"
+          "  calls     folded stacks of the traced calls for flamegraph.pl (traceMode 3)\n"
+          "            --folded=<file> instead of stdout, --chrome=<file> Chrome trace JSON\n"
+          "  fields    field reads and writes with their values (traceMode 4)\n"
+          "  jni       JNI calls made by native code and their callers (isJNIMethodPrint)\n"
+          "  jniprofile JNI call counts and latency per caller/function/target (jniTraceMode 1)\n"
+          "            --top=<n> rows listed, default all\n"
+          "  jnidata   string and byte array payloads of JNI calls (jniDataMaxBytes)\n"
+          "            --data=<mikrom_<pid>.jnidata> required, --bytes=<n> dumped per payload,\n"
+          "            --out=<dir> also writes each payload to <dir>/<hash>.bin\n"
+          "  natives   native bindings from mikrom_<pid>.natives (isRegisterNativePrint,\n"
+          "            written on MikRomManager.requestNativeRegistryDump)\n"
+          "  invokes   caller -> callee counts of reflective and JNI calls (isInvokePrint)\n"
+          "            --top=<n> edges listed, --dot=<file> also writes a Graphviz digraph\n"
+          "\n"
+          "--dex takes .dex/.apk files or dumped dexes; they are matched by checksum.\n");
+}
+
+static bool ParseArgs(int argc, char** argv, CommandArgs* args) {
+  std::string trace_path;
+  for (int i = 0; i < argc; ++i) {
+    std::string arg(argv[i]);
+    std::string error_msg;
+    if (android::base::StartsWith(arg, "--dex=")) {
+      if (!args->dex_set.Add(arg.substr(strlen("--dex=")), &error_msg)) {
+        fprintf(stderr, "%s\n", error_msg.c_str());
+        return false;
+      }
+    } else if (android::base::StartsWith(arg, "--")) {
+      args->extra.push_back(arg);
+    } else if (trace_path.empty()) {
+      trace_path = arg;
+    } else {
+      fprintf(stderr, "Unexpected argument %s\n", arg.c_str());
+      return false;
+    }
+  }
+  if (trace_path.empty()) {
+    return false;
+  }
+  std::string error_msg;
+  if (!args->trace.Open(trace_path, &error_msg)) {
+    fprintf(stderr, "%s\n", error_msg.c_str());
+    return false;
+  }
+  if (args->trace.DroppedRecords() != 0) {
+    fprintf(stderr, "Warning: the device dropped %llu records\n",
+            static_cast<unsigned long long>(args->trace.DroppedRecords()));
+  }
+  return true;
+}
+
+static int Main(int argc, char** argv) {
+  if (argc < 3) {
+    Usage();
+    return 1;
+  }
+  std::string command(argv[1]);
+  CommandArgs args;
+  if (!ParseArgs(argc - 2, argv + 2, &args)) {
+    Usage();
+    return 1;
+  }
+  if (command == "smali") {
+    return SmaliCommand(args);
+  }
+  if (command == "coverage") {
+    return CoverageCommand(args);
+  }
+  if (command == "profile") {
+    return ProfileCommand(args);
+  }
+  if (command == "calls") {
+    return CallsCommand(args);
+  }
+  if (command == "fields") {
+    return FieldsCommand(args);
+  }
+  if (command == "jni") {
+    return JniCommand(args);
+  }
+  if (command == "jnidata") {
+    return JniDataCommand(args);
+  }
+  if (command == "jniprofile") {
+    return JniProfileCommand(args);
+  }
+  if (command == "invokes") {
+    return InvokesCommand(args);
+  }
+  if (command == "natives") {
+    return NativesCommand(args);
+  }
+  fprintf(stderr, "Unknown command %s\n", command.c_str());
+  Usage();
+  return 1;
+}
+
+}  // namespace mikrom
+}  // namespace art
+
+int main(int argc, char** argv) {
+  return art::mikrom::Main(argc, argv);
+}
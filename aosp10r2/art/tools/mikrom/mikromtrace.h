@@ -0,0 +1,43 @@
+// change mikrom
+#ifndef ART_TOOLS_MIKROM_MIKROMTRACE_H_
+#define ART_TOOLS_MIKROM_MIKROMTRACE_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dex_set.h"
+#include "trace_reader.h"
+
+namespace art {
+namespace mikrom {
+
+// Options shared by every command: --dex=<file> (repeatable) and the trace file.
+// Anything else is left in |extra| for the command to interpret.
+struct CommandArgs {
+  TraceReader trace;
+  DexSet dex_set;
+  std::vector<std::string> extra;
+};
+
+// String table of the JNI trace (JniStringRecords), by string id.
+using JniStringTable = std::unordered_map<uint32_t, std::string>;
+JniStringTable ReadJniStrings(const TraceReader& trace);
+// File name of the module with string id |module_id|.
+std::string JniModuleName(const JniStringTable& strings, uint32_t module_id);
+
+int CallsCommand(CommandArgs& args);
+int CoverageCommand(CommandArgs& args);
+int FieldsCommand(CommandArgs& args);
+int InvokesCommand(CommandArgs& args);
+int JniCommand(CommandArgs& args);
+int JniDataCommand(CommandArgs& args);
+int JniProfileCommand(CommandArgs& args);
+int NativesCommand(CommandArgs& args);
+int ProfileCommand(CommandArgs& args);
+int SmaliCommand(CommandArgs& args);
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_TOOLS_MIKROM_MIKROMTRACE_H_
@@ -0,0 +1,80 @@
+// change mikrom
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <android-base/stringprintf.h>
+
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+namespace {
+
+struct NativeBinding {
+  std::string method;
+  std::string module;
+  NativeRecord record;
+};
+
+}  // namespace
+
+// Lists the native bindings in a mikrom_<pid>.natives snapshot
+// (isRegisterNativePrint), grouped by module in address order:
+//   <module>+<offset>\t<method>\tregistered:<n>\ttid:<tid>\tat:<ms since boot>
+int NativesCommand(CommandArgs& args) {
+  std::vector<NativeBinding> bindings;
+  args.trace.ForEachRecord([&](uint32_t, const RecordHeader* header) {
+    if (header->type != kRecordNative) {
+      return;
+    }
+    NativeBinding binding;
+    memcpy(&binding.record, header, sizeof(binding.record));
+    const NativeRecord& record = binding.record;
+    if (sizeof(record) + static_cast<uint64_t>(record.name_length) + record.module_length >
+        header->size) {
+      return;
+    }
+    const char* strings = reinterpret_cast<const char*>(header) + sizeof(record);
+    binding.method.assign(strings, record.name_length);
+    binding.module.assign(strings + record.name_length, record.module_length);
+    size_t slash = binding.module.rfind('/');
+    if (slash != std::string::npos) {
+      binding.module = binding.module.substr(slash + 1);
+    }
+    bindings.push_back(std::move(binding));
+  });
+  std::sort(bindings.begin(), bindings.end(), [](const NativeBinding& a, const NativeBinding& b) {
+    return std::tie(a.module, a.record.offset) < std::tie(b.module, b.record.offset);
+  });
+
+  for (const NativeBinding& binding : bindings) {
+    const NativeRecord& record = binding.record;
+    std::string target;
+    if (record.native == 0) {
+      target = "<unregistered>";
+    } else if (binding.module.empty()) {
+      target = StringPrintf("0x%" PRIx64, record.native);
+    } else {
+      target = StringPrintf("%s+0x%" PRIx64, binding.module.c_str(), record.offset);
+    }
+    printf("%s\t%s\tregistered:%u\ttid:%u\tat:%.3f\n",
+           target.c_str(),
+           binding.method.c_str(),
+           record.registrations,
+           record.tid,
+           record.time_ns / 1000000.0);
+  }
+  return 0;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,128 @@
+// change mikrom
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <android-base/stringprintf.h>
+#include <android-base/strings.h>
+
+#include "dex/dex_file.h"
+#include "dex/dex_instruction.h"
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+namespace {
+
+struct SampledMethod {
+  std::string name;
+  const DexFile* dex_file = nullptr;
+  std::vector<uint16_t> insns;
+  std::map<uint32_t, uint32_t> counts;  // dex_pc -> samples
+  uint64_t total = 0;
+};
+
+}  // namespace
+
+// Prints the dex_pc histogram of every method traced in sampling mode, hottest
+// method first. --top=<n> limits the instructions listed per method.
+int ProfileCommand(CommandArgs& args) {
+  size_t top = 20;
+  for (const std::string& arg : args.extra) {
+    if (android::base::StartsWith(arg, "--top=")) {
+      top = strtoul(arg.c_str() + strlen("--top="), nullptr, 10);
+    } else {
+      fprintf(stderr, "Unknown option %s\n", arg.c_str());
+      return 1;
+    }
+  }
+
+  std::map<uint32_t, SampledMethod> methods;
+  args.trace.ForEachRecord([&](uint32_t, const RecordHeader* header) {
+    if (header->type == kRecordMethod) {
+      MethodRecord record;
+      memcpy(&record, header, sizeof(record));
+      SampledMethod& method = methods[record.method_id];
+      method.insns.resize(record.insns_size);
+      memcpy(method.insns.data(),
+             reinterpret_cast<const uint8_t*>(header) + sizeof(record),
+             record.insns_size * sizeof(uint16_t));
+      method.dex_file = args.dex_set.Find(record.dex_checksum);
+      if (method.dex_file != nullptr) {
+        method.name = method.dex_file->PrettyMethod(record.method_idx);
+      } else {
+        method.name = StringPrintf("<dex %08x>.method@%u", record.dex_checksum, record.method_idx);
+      }
+    } else if (header->type == kRecordSamples) {
+      SamplesRecord record;
+      memcpy(&record, header, sizeof(record));
+      if (sizeof(record) + record.entry_count * sizeof(SampleEntry) > header->size) {
+        return;
+      }
+      // Snapshots are cumulative, keep the largest count seen for each pc.
+      SampledMethod& method = methods[record.method_id];
+      const uint8_t* data = reinterpret_cast<const uint8_t*>(header) + sizeof(record);
+      for (uint32_t i = 0; i < record.entry_count; ++i) {
+        SampleEntry entry;
+        memcpy(&entry, data + i * sizeof(entry), sizeof(entry));
+        uint32_t& count = method.counts[entry.dex_pc];
+        count = std::max(count, entry.count);
+      }
+    }
+  });
+
+  std::vector<SampledMethod*> sorted;
+  uint64_t total = 0;
+  for (auto& entry : methods) {
+    SampledMethod& method = entry.second;
+    for (const auto& count : method.counts) {
+      method.total += count.second;
+    }
+    if (method.total != 0) {
+      total += method.total;
+      sorted.push_back(&method);
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const SampledMethod* a, const SampledMethod* b) {
+    return a->total > b->total;
+  });
+
+  for (const SampledMethod* method : sorted) {
+    printf("%s %llu samples (%.1f%%)\n",
+           method->name.c_str(),
+           static_cast<unsigned long long>(method->total),
+           100.0 * method->total / total);
+    std::vector<std::pair<uint32_t, uint32_t>> pcs(method->counts.begin(), method->counts.end());
+    std::sort(pcs.begin(), pcs.end(), [](const auto& a, const auto& b) {
+      return a.second > b.second;
+    });
+    if (pcs.size() > top) {
+      pcs.resize(top);
+    }
+    for (const auto& pc : pcs) {
+      std::string smali = "<out of range>";
+      if (pc.first < method->insns.size()) {
+        const Instruction* inst = Instruction::At(method->insns.data() + pc.first);
+        smali = pc.first + inst->SizeInCodeUnits() <= method->insns.size()
+            ? inst->DumpString(method->dex_file)
+            : "<truncated>";
+      }
+      printf("  %8u %5.1f%% 0x%04x: %s\n",
+             pc.second,
+             100.0 * pc.second / method->total,
+             pc.first,
+             smali.c_str());
+    }
+  }
+  return 0;
+}
+
+}  // namespace mikrom
+}  // namespace art
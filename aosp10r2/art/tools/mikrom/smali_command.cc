@@ -0,0 +1,88 @@
+// change mikrom
+#include <stdio.h>
+#include <string.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include <android-base/stringprintf.h>
+
+#include "dex/dex_file.h"
+#include "dex/dex_instruction.h"
+#include "mikromtrace.h"
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+namespace {
+
+struct TracedMethod {
+  std::string name;
+  const DexFile* dex_file = nullptr;
+  std::vector<uint16_t> insns;
+};
+
+}  // namespace
+
+// Rebuilds the "mikrom smaliTrace" listing that the device used to log directly.
+int SmaliCommand(CommandArgs& args) {
+  std::unordered_map<uint32_t, TracedMethod> methods;
+  args.trace.ForEachRecord([&](uint32_t, const RecordHeader* header) {
+    if (header->type != kRecordMethod) {
+      return;
+    }
+    MethodRecord record;
+    memcpy(&record, header, sizeof(record));
+    TracedMethod& method = methods[record.method_id];
+    method.insns.resize(record.insns_size);
+    memcpy(method.insns.data(),
+           reinterpret_cast<const uint8_t*>(header) + sizeof(record),
+           record.insns_size * sizeof(uint16_t));
+    method.dex_file = args.dex_set.Find(record.dex_checksum);
+    if (method.dex_file != nullptr) {
+      method.name = method.dex_file->PrettyMethod(record.method_idx);
+    } else {
+      method.name = StringPrintf("<dex %08x>.method@%u", record.dex_checksum, record.method_idx);
+    }
+  });
+
+  uint32_t last_tid = 0;
+  uint32_t last_method = 0;
+  args.trace.ForEachRecord([&](uint32_t tid, const RecordHeader* header) {
+    if (header->type != kRecordInstruction) {
+      return;
+    }
+    InstructionRecord record;
+    memcpy(&record, header, sizeof(record));
+    auto it = methods.find(record.method_id);
+    if (it == methods.end()) {
+      printf("[%u] unknown method id %u pc 0x%x\n", tid, record.method_id, record.dex_pc);
+      return;
+    }
+    const TracedMethod& method = it->second;
+    if (tid != last_tid || record.method_id != last_method) {
+      printf("[%u] %s\n", tid, method.name.c_str());
+      last_tid = tid;
+      last_method = record.method_id;
+    }
+    if (record.dex_pc >= method.insns.size()) {
+      printf("[%u] mikrom smaliTrace 0x%x: <out of range>\n", tid, record.dex_pc);
+      return;
+    }
+    const Instruction* inst = Instruction::At(method.insns.data() + record.dex_pc);
+    if (record.dex_pc + inst->SizeInCodeUnits() > method.insns.size()) {
+      printf("[%u] mikrom smaliTrace 0x%x: <truncated>\n", tid, record.dex_pc);
+      return;
+    }
+    printf("[%u] mikrom smaliTrace 0x%x: %s\n",
+           tid,
+           record.dex_pc,
+           inst->DumpString(method.dex_file).c_str());
+  });
+  return 0;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,71 @@
+// change mikrom
+#include "trace_reader.h"
+
+#include <string.h>
+
+#include <android-base/file.h>
+#include <android-base/stringprintf.h>
+
+namespace art {
+namespace mikrom {
+
+using android::base::StringPrintf;
+
+bool TraceReader::Open(const std::string& path, std::string* error_msg) {
+  if (!android::base::ReadFileToString(path, &data_)) {
+    *error_msg = StringPrintf("Failed to read %s", path.c_str());
+    return false;
+  }
+  if (data_.size() < sizeof(header_)) {
+    *error_msg = StringPrintf("%s is too short", path.c_str());
+    return false;
+  }
+  memcpy(&header_, data_.data(), sizeof(header_));
+  if (header_.magic != kTraceFileMagic || header_.version != kTraceVersion) {
+    *error_msg = StringPrintf("%s is not a mikrom trace (version %u expected)",
+                              path.c_str(),
+                              kTraceVersion);
+    return false;
+  }
+  dropped_ = Walk([](uint32_t, const RecordHeader*) {});
+  return true;
+}
+
+void TraceReader::ForEachRecord(const Visitor& visitor) const {
+  Walk(visitor);
+}
+
+uint64_t TraceReader::Walk(const Visitor& visitor) const {
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(data_.data());
+  const uint8_t* end = begin + data_.size();
+  const uint8_t* pos = begin + header_.header_size;
+  uint64_t dropped = 0;
+  while (pos + sizeof(TraceChunkHeader) <= end) {
+    TraceChunkHeader chunk;
+    memcpy(&chunk, pos, sizeof(chunk));
+    if (chunk.magic != kTraceChunkMagic) {
+      fprintf(stderr, "Bad chunk at offset %zu, stopping\n", static_cast<size_t>(pos - begin));
+      break;
+    }
+    pos += sizeof(chunk);
+    if (pos + chunk.size > end) {
+      break;
+    }
+    dropped += chunk.dropped;
+    const uint8_t* chunk_end = pos + chunk.size;
+    while (pos + sizeof(RecordHeader) <= chunk_end) {
+      const RecordHeader* record = reinterpret_cast<const RecordHeader*>(pos);
+      if (record->size < sizeof(RecordHeader) || pos + record->size > chunk_end) {
+        fprintf(stderr, "Bad record in chunk of thread %u\n", chunk.tid);
+        break;
+      }
+      visitor(chunk.tid, record);
+      pos += record->size;
+    }
+    pos = chunk_end;
+  }
+  return dropped;
+}
+
+}  // namespace mikrom
+}  // namespace art
@@ -0,0 +1,41 @@
+// change mikrom
+#ifndef ART_TOOLS_MIKROM_TRACE_READER_H_
+#define ART_TOOLS_MIKROM_TRACE_READER_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+
+#include "mikrom/trace_format.h"
+
+namespace art {
+namespace mikrom {
+
+// Reads a whole trace file written by art/runtime/mikrom/trace_buffer.cc.
+class TraceReader {
+ public:
+  using Visitor = std::function<void(uint32_t tid, const RecordHeader* record)>;
+
+  bool Open(const std::string& path, std::string* error_msg);
+
+  // Calls |visitor| for every record in file order. Truncated trailing data, as
+  // left by a killed process, is ignored.
+  void ForEachRecord(const Visitor& visitor) const;
+
+  const TraceFileHeader& Header() const { return header_; }
+  uint64_t DroppedRecords() const { return dropped_; }
+
+ private:
+  // Returns the number of records the device dropped.
+  uint64_t Walk(const Visitor& visitor) const;
+
+  std::string data_;
+  TraceFileHeader header_;
+  uint64_t dropped_ = 0;
+};
+
+}  // namespace mikrom
+}  // namespace art
+
+#endif  // ART_TOOLS_MIKROM_TRACE_READER_H_
@@ -6436,8 +6436,7 @@ public final class ActivityThread extends ClientTransactionHandler {
         try {
             //add
             int flags = mBoundApplication == null ? 0 : mBoundApplication.appInfo.flags;
-            if(flags>0&&((flags&ApplicationInfo.FLAG_SYSTEM)!=1)){
-                Fartext.initConfig();
+            if(flags>0&&((flags&ApplicationInfo.FLAG_SYSTEM)!=1)&&Fartext.initConfig()){
                 Fartext.loadGadget();
                 Fartext.loadConfigSo();
             }
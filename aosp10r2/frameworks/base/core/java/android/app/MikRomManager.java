@@ -2,8 +2,17 @@ package android.app;
 // change mikrom
 import android.annotation.SystemService;
 import android.content.Context;
+import android.os.ParcelFileDescriptor;
 import android.os.RemoteException;
 import android.util.Slog;
+
+import libcore.io.IoUtils;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.nio.charset.StandardCharsets;
 @SystemService(Context.MIKROM_SERVICE)
 public class MikRomManager {
     Context mContext;
@@ -31,13 +40,29 @@ public class MikRomManager {
         return "";
     }
 
+    //读取openFile返回的fd的全部内容并关闭fd
+    public static String readFully(ParcelFileDescriptor pfd) throws IOException {
+        try (InputStream in=new ParcelFileDescriptor.AutoCloseInputStream(pfd)) {
+            ByteArrayOutputStream out=new ByteArrayOutputStream();
+            byte[] buf=new byte[64*1024];
+            int n;
+            while((n=in.read(buf))!=-1){
+                out.write(buf,0,n);
+            }
+            return new String(out.toByteArray(),StandardCharsets.UTF_8);
+        }
+    }
+
     public String readFile(String path){
         if(mService != null){
             try{
                 Slog.e("MikRomManager","readFile");
-                return mService.readFile(path);
+                ParcelFileDescriptor pfd=mService.openFile(path);
+                return pfd!=null?readFully(pfd):"";
             }catch(RemoteException e){
                 Slog.e("MikRomManager","RemoteException "+e);
+            }catch(IOException e){
+                Slog.e("MikRomManager","readFile "+path+" "+e);
             }
         }else{
             Slog.e("MikRomManager","mService is null");
@@ -45,13 +70,74 @@ public class MikRomManager {
         return "";
     }
 
+    public void requestJniProfileDump(String packageName){
+        if(mService != null){
+            try{
+                Slog.e("MikRomManager","requestJniProfileDump");
+                mService.requestJniProfileDump(packageName);
+            }catch(RemoteException e){
+                Slog.e("MikRomManager","RemoteException "+e);
+            }
+        }else{
+            Slog.e("MikRomManager","mService is null");
+        }
+    }
+
+    public void requestDebugRelease(String packageName){
+        if(mService != null){
+            try{
+                Slog.e("MikRomManager","requestDebugRelease");
+                mService.requestDebugRelease(packageName);
+            }catch(RemoteException e){
+                Slog.e("MikRomManager","RemoteException "+e);
+            }
+        }else{
+            Slog.e("MikRomManager","mService is null");
+        }
+    }
+
+    public void requestNativeRegistryDump(String packageName){
+        if(mService != null){
+            try{
+                Slog.e("MikRomManager","requestNativeRegistryDump");
+                mService.requestNativeRegistryDump(packageName);
+            }catch(RemoteException e){
+                Slog.e("MikRomManager","RemoteException "+e);
+            }
+        }else{
+            Slog.e("MikRomManager","mService is null");
+        }
+    }
+
+    //数据通过管道写给MikRomService,大小不受binder事务限制
     public void writeFile(String path,String data){
         if(mService != null){
+            ParcelFileDescriptor readEnd=null;
             try{
                 Slog.e("MikRomManager","writeFile");
-                mService.writeFile(path,data);
+                final byte[] bytes=data.getBytes(StandardCharsets.UTF_8);
+                ParcelFileDescriptor[] pipe=ParcelFileDescriptor.createPipe();
+                final ParcelFileDescriptor writeEnd=pipe[1];
+                Thread writer=new Thread(new Runnable() {
+                    @Override
+                    public void run() {
+                        try (OutputStream out=new ParcelFileDescriptor.AutoCloseOutputStream(writeEnd)) {
+                            out.write(bytes);
+                        } catch (IOException e) {
+                            Slog.e("MikRomManager","writeFile pipe "+e);
+                        }
+                    }
+                });
+                writer.start();
+                readEnd=pipe[0];
+                mService.writeFileFd(path,readEnd);
             }catch(RemoteException e){
                 Slog.e("MikRomManager","RemoteException "+e);
+            }catch(IOException e){
+                Slog.e("MikRomManager","writeFile "+path+" "+e);
+            }finally{
+                //关闭读端,服务端异常时写线程也会因管道断开而退出
+                IoUtils.closeQuietly(readEnd);
             }
         }else{
             Slog.e("MikRomManager","mService is null");
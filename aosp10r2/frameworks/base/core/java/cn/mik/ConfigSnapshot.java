@@ -0,0 +1,151 @@
+package cn.mik;
+// change mikrom
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+import java.util.Iterator;
+
+import org.json.JSONObject;
+
+//把mik.conf中一个包的配置编译成art/runtime/mikrom/package_config.h定义的二进制格式,
+//由DexFile.loadMikRomConfig加载。art那边整体替换配置对象,运行中更新也不会读到一半的配置。
+public class ConfigSnapshot {
+    private static final int MAGIC = 0x434b494d;
+    private static final int FORMAT_VERSION = 1;
+    private static final int TYPE_BOOL = 0;
+    private static final int TYPE_INT = 1;
+    private static final int TYPE_STRING = 2;
+
+    private static void writeEntry(ByteArrayOutputStream out, int type, String key, byte[] value){
+        byte[] keyBytes = key.getBytes(StandardCharsets.UTF_8);
+        ByteBuffer header = ByteBuffer.allocate(8).order(ByteOrder.LITTLE_ENDIAN);
+        header.put((byte) type);
+        header.put((byte) keyBytes.length);
+        header.putShort((short) 0);
+        header.putInt(value.length);
+        out.write(header.array(), 0, 8);
+        out.write(keyBytes, 0, keyBytes.length);
+        out.write(value, 0, value.length);
+    }
+
+    //返回newCfg中与oldCfg不同的字段,oldCfg为null时返回全部字段。
+    //oldCfg有而newCfg没有的字段(newCfg为null即包被禁用或删除)按类型填默认值,和art里的初始值一致
+    public static JSONObject diff(JSONObject oldCfg, JSONObject newCfg){
+        JSONObject changed = new JSONObject();
+        if (newCfg != null) {
+            Iterator<String> keys = newCfg.keys();
+            while (keys.hasNext()) {
+                String key = keys.next();
+                Object value = newCfg.opt(key);
+                if (oldCfg != null && value != null && value.equals(oldCfg.opt(key))) {
+                    continue;
+                }
+                try {
+                    changed.put(key, value);
+                } catch (Exception e) {
+                    //key不为null时不会失败
+                }
+            }
+        }
+        if (oldCfg != null) {
+            Iterator<String> keys = oldCfg.keys();
+            while (keys.hasNext()) {
+                String key = keys.next();
+                if ("packageName".equals(key) || (newCfg != null && newCfg.has(key))) {
+                    continue;
+                }
+                Object value = defaultOf(oldCfg.opt(key));
+                if (value == null) {
+                    continue;
+                }
+                try {
+                    changed.put(key, value);
+                } catch (Exception e) {
+                    //key不为null时不会失败
+                }
+            }
+        }
+        return changed;
+    }
+
+    private static Object defaultOf(Object value){
+        if (value instanceof Boolean) {
+            return Boolean.FALSE;
+        } else if (value instanceof Integer) {
+            return Integer.valueOf(0);
+        } else if (value instanceof String) {
+            return "";
+        }
+        return null;
+    }
+
+    //compile的逆过程,格式不对时返回null
+    public static JSONObject parse(byte[] data){
+        try {
+            ByteBuffer buf = ByteBuffer.wrap(data).order(ByteOrder.LITTLE_ENDIAN);
+            if (buf.getInt() != MAGIC || buf.getInt() != FORMAT_VERSION) {
+                return null;
+            }
+            int count = buf.getInt();
+            JSONObject jobj = new JSONObject();
+            for (int i = 0; i < count; i++) {
+                int type = buf.get() & 0xff;
+                int keyLength = buf.get() & 0xff;
+                buf.getShort();
+                int valueLength = buf.getInt();
+                byte[] key = new byte[keyLength];
+                buf.get(key);
+                byte[] value = new byte[valueLength];
+                buf.get(value);
+                String name = new String(key, StandardCharsets.UTF_8);
+                if (type == TYPE_BOOL && valueLength == 1) {
+                    jobj.put(name, value[0] != 0);
+                } else if (type == TYPE_INT && valueLength == 4) {
+                    jobj.put(name, ByteBuffer.wrap(value).order(ByteOrder.LITTLE_ENDIAN).getInt());
+                } else if (type == TYPE_STRING) {
+                    jobj.put(name, new String(value, StandardCharsets.UTF_8));
+                }
+            }
+            return jobj;
+        } catch (Exception e) {
+            //长度不够时BufferUnderflowException
+            return null;
+        }
+    }
+
+    //json中的布尔,整数和字符串字段都写入,art只取认识的字段
+    public static byte[] compile(JSONObject jobj){
+        ByteArrayOutputStream entries = new ByteArrayOutputStream();
+        int count = 0;
+        Iterator<String> keys = jobj.keys();
+        while (keys.hasNext()) {
+            String key = keys.next();
+            if (key.getBytes(StandardCharsets.UTF_8).length > 255) {
+                continue;
+            }
+            Object value = jobj.opt(key);
+            if (value instanceof Boolean) {
+                writeEntry(entries, TYPE_BOOL, key, new byte[] {(byte) (((Boolean) value) ? 1 : 0)});
+            } else if (value instanceof Integer) {
+                byte[] v = ByteBuffer.allocate(4).order(ByteOrder.LITTLE_ENDIAN)
+                        .putInt((Integer) value).array();
+                writeEntry(entries, TYPE_INT, key, v);
+            } else if (value instanceof String) {
+                writeEntry(entries, TYPE_STRING, key, ((String) value).getBytes(StandardCharsets.UTF_8));
+            } else {
+                continue;
+            }
+            count++;
+        }
+        ByteBuffer header = ByteBuffer.allocate(12).order(ByteOrder.LITTLE_ENDIAN);
+        header.putInt(MAGIC);
+        header.putInt(FORMAT_VERSION);
+        header.putInt(count);
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        out.write(header.array(), 0, 12);
+        byte[] body = entries.toByteArray();
+        out.write(body, 0, body.length);
+        return out.toByteArray();
+    }
+}
@@ -3,8 +3,11 @@ package cn.mik;
 import android.app.ActivityThread;
 import android.app.Application;
 import android.app.IMikRom;
+import android.app.IMikRomCallback;
+import android.app.MikRomManager;
 import android.os.FileUtils;
 import android.os.IBinder;
+import android.os.ParcelFileDescriptor;
 import android.os.RemoteException;
 import android.os.ServiceManager;
 import android.util.Log;
@@ -17,6 +20,7 @@ import java.io.File;
 import java.io.FileWriter;
 import java.io.IOException;
 import java.io.InputStream;
+import java.io.InputStreamReader;
 import java.io.OutputStream;
 import java.lang.reflect.Constructor;
 import java.lang.reflect.Field;
@@ -24,6 +28,7 @@ import java.lang.reflect.InvocationTargetException;
 import java.lang.reflect.Method;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.Iterator;
 import java.util.List;
 import org.json.JSONArray;
 import org.json.JSONException;
@@ -31,6 +36,7 @@ import org.json.JSONObject;
 
 import cn.mik.iohook.NativeEngine;
 import dalvik.system.DexClassLoader;
+import libcore.io.IoUtils;
 
 public class Fartext {
     //为了反射封装，根据类名和字段名，反射获取字段
@@ -190,6 +196,134 @@ public class Fartext {
         return iswhite;
     }
 
+    private static Method getDexFileMethod(Class DexFileClazz, String name){
+        for (Method method : DexFileClazz.getDeclaredMethods()) {
+            if (method.getName().equals(name)) {
+                method.setAccessible(true);
+                return method;
+            }
+        }
+        return null;
+    }
+
+    //白名单和黑名单编译成native的自动机,返回{白名单句柄,黑名单句柄},句柄为0表示不过滤,native不可用时返回null
+    private static long[] compileClassMatchers(Class DexFileClazz){
+        Method compile=getDexFileMethod(DexFileClazz,"compileClassMatcher");
+        if(compile==null){
+            return null;
+        }
+        List<String> white=new ArrayList<String>(whiteClass);
+        List<String> black=new ArrayList<String>();
+        for(String item :bClass){
+            if(item.trim().length()>0){
+                black.add(item);
+            }
+        }
+        long[] matchers=new long[2];
+        try {
+            //白名单里有空串时所有类都算白名单,与isWhiteClass一致
+            if(white.size()>0 && !white.contains("")){
+                matchers[0]=(Long)compile.invoke(null,(Object)white.toArray(new String[0]));
+            }
+            if(black.size()>0){
+                matchers[1]=(Long)compile.invoke(null,(Object)black.toArray(new String[0]));
+            }
+            return matchers;
+        } catch (Exception e) {
+            Log.e("mikrom", "compileClassMatcher err:"+e.getMessage());
+            releaseClassMatchers(DexFileClazz,matchers);
+            return null;
+        }
+    }
+
+    private static void releaseClassMatchers(Class DexFileClazz, long[] matchers){
+        Method release=getDexFileMethod(DexFileClazz,"releaseClassMatcher");
+        if(release==null||matchers==null){
+            return;
+        }
+        try {
+            for(long matcher :matchers){
+                if(matcher!=0){
+                    release.invoke(null,matcher);
+                }
+            }
+        } catch (Exception e) {
+            Log.e("mikrom", "releaseClassMatcher err:"+e.getMessage());
+        }
+    }
+
+    //白名单和黑名单编译成native的自动机后整批过滤,返回保留的下标,native不可用时返回null由调用方逐个判断
+    public static int[] filterClassNames(Class DexFileClazz, String[] names){
+        Method filter=getDexFileMethod(DexFileClazz,"filterClassNames");
+        if(filter==null){
+            return null;
+        }
+        long[] matchers=compileClassMatchers(DexFileClazz);
+        if(matchers==null){
+            return null;
+        }
+        try {
+            long start=System.nanoTime();
+            int[] kept=(int[])filter.invoke(null,matchers[0],matchers[1],(Object)names);
+            Log.e("mikrom", "filterClassNames kept "+kept.length+"/"+names.length+" in "+(System.nanoTime()-start)/1000+"us");
+            return kept;
+        } catch (Exception e) {
+            Log.e("mikrom", "filterClassNames err:"+e.getMessage());
+            return null;
+        } finally {
+            releaseClassMatchers(DexFileClazz,matchers);
+        }
+    }
+
+    //每次从native取的class_def数量,只有通过过滤的类会创建String
+    private static final int CLASS_CHUNK_SIZE = 2048;
+
+    //分段取出cookie中通过白名单黑名单的类并主动调用,不生成完整的类名数组。native不可用时返回false由调用方走getClassNameList
+    private static boolean invokeFilteredClasses(Class DexFileClazz, Object mcookie, ClassLoader appClassloader, Method dumpMethodCode_method){
+        Method getCount=getDexFileMethod(DexFileClazz,"getClassDefCount");
+        Method getNames=getDexFileMethod(DexFileClazz,"getFilteredClassNames");
+        Method indexClassDefs=getDexFileMethod(DexFileClazz,"indexClassDefs");
+        Method releaseIndex=getDexFileMethod(DexFileClazz,"releaseClassDefIndex");
+        if(getCount==null||getNames==null||indexClassDefs==null||releaseIndex==null){
+            return false;
+        }
+        long[] matchers=compileClassMatchers(DexFileClazz);
+        if(matchers==null){
+            return false;
+        }
+        long index=0;
+        try {
+            int total=(Integer)getCount.invoke(null,mcookie);
+            //多dex去重用的索引每个cookie只建一次,所有分段共用
+            index=(Long)indexClassDefs.invoke(null,mcookie);
+            int kept=0;
+            for(int start=0;start<total;start+=CLASS_CHUNK_SIZE){
+                String[] names=(String[])getNames.invoke(null,mcookie,matchers[0],matchers[1],index,start,CLASS_CHUNK_SIZE);
+                if(names==null){
+                    continue;
+                }
+                kept+=names.length;
+                for(String name :names){
+                    invokeClass(appClassloader, name, dumpMethodCode_method);
+                }
+            }
+            Log.e("mikrom", "invokeFilteredClasses kept "+kept+"/"+total);
+            return true;
+        } catch (Exception e) {
+            Log.e("mikrom", "invokeFilteredClasses err:"+e.getMessage());
+            return false;
+        } finally {
+            releaseClassMatchers(DexFileClazz,matchers);
+            if(index!=0){
+                try {
+                    releaseIndex.invoke(null,index);
+                } catch (Exception e) {
+                    Log.e("mikrom", "releaseClassDefIndex err:"+e.getMessage());
+                }
+            }
+        }
+    }
+
     //取指定类的所有构造函数，和所有函数，使用dumpMethodCode函数来把这些函数给保存出来
     public static int loadClassAndInvoke(ClassLoader appClassloader, String eachclassname, Method dumpMethodCode_method) {
         if(whiteClass.size()>0){
@@ -211,7 +345,11 @@ public class Fartext {
                 }
             }
         }
+        return invokeClass(appClassloader, eachclassname, dumpMethodCode_method);
+    }
 
+    //加载类并主动调用所有构造函数和函数,调用方已按黑白名单过滤
+    public static int invokeClass(ClassLoader appClassloader, String eachclassname, Method dumpMethodCode_method) {
         Class resultclass = null;
         Log.e("mikrom", "go into loadClassAndInvoke->" + "classname:" + eachclassname);
         try {
@@ -382,8 +520,13 @@ public class Fartext {
 
                 }
                 String[] classnames = null;
+                boolean streamed = false;
                 try {
-                    classnames = (String[]) getClassNameList_method.invoke(dexfile, mcookie);
+                    streamed = invokeFilteredClasses(DexFileClazz, mcookie, appClassloader, dumpMethodCode_method);
+                    if (!streamed) {
+                        classnames = (String[]) getClassNameList_method.invoke(dexfile, mcookie);
+                        Log.e("mikrom", "all classes "+String.join(",",classnames));
+                    }
                 } catch (Exception e) {
                     e.printStackTrace();
                     continue;
@@ -391,10 +534,16 @@ public class Fartext {
                     e.printStackTrace();
                     continue;
                 }
-                if (classnames != null) {
-                    Log.e("mikrom", "all classes "+String.join(",",classnames));
-                    for (String eachclassname : classnames) {
-                        loadClassAndInvoke(appClassloader, eachclassname, dumpMethodCode_method);
+                if (streamed || classnames != null) {
+                    int[] kept = streamed ? null : filterClassNames(DexFileClazz, classnames);
+                    if (kept != null) {
+                        for (int index : kept) {
+                            invokeClass(appClassloader, classnames[index], dumpMethodCode_method);
+                        }
+                    } else if (!streamed) {
+                        for (String eachclassname : classnames) {
+                            loadClassAndInvoke(appClassloader, eachclassname, dumpMethodCode_method);
+                        }
                     }
                     if(dumpRepair_method!=null){
                         Log.e("mikrom", "fartWithClassLoader dumpRepair");
@@ -451,28 +600,207 @@ public class Fartext {
             e.printStackTrace();
         }
         Method setMikRomConfig_method = null;
+        Method loadMikRomConfig_method = null;
         for (Method field : DexFileClazz.getDeclaredMethods()) {
             if (field.getName().equals("setMikRomConfig")) {
                 setMikRomConfig_method = field;
                 setMikRomConfig_method.setAccessible(true);
             }
+            if (field.getName().equals("loadMikRomConfig")) {
+                loadMikRomConfig_method = field;
+                loadMikRomConfig_method.setAccessible(true);
+            }
         }
         if(setMikRomConfig_method==null){
             Log.e("mikrom", "SetRomConfig setMikRomConfig_method is null");
             return;
         }
+        //优先加载MikRomService生成的二进制配置,失败时退回逐个字段设置
+        boolean loaded=false;
         try{
-            Log.e("mikrom", "SetRomConfig invoke");
-            setMikRomConfig_method.invoke(null,item);
+            IMikRom mikrom=getiMikRom();
+            byte[] snapshot=mikrom!=null?mikrom.getPackageConfig(item.packageName):null;
+            if(snapshot!=null && loadMikRomConfig_method!=null){
+                Log.e("mikrom", "SetRomConfig load snapshot size:"+snapshot.length);
+                loaded=(Boolean)loadMikRomConfig_method.invoke(null,snapshot);
+            }
         }catch (Exception e) {
-            Log.e("mikrom", "SetRomConfig setMikRomConfig_method.invoke "+e.getMessage());
-            e.printStackTrace();
+            Log.e("mikrom", "SetRomConfig loadMikRomConfig_method.invoke "+e.getMessage());
+        }
+        if(!loaded){
+            try{
+                Log.e("mikrom", "SetRomConfig invoke");
+                setMikRomConfig_method.invoke(null,item);
+            }catch (Exception e) {
+                Log.e("mikrom", "SetRomConfig setMikRomConfig_method.invoke "+e.getMessage());
+                e.printStackTrace();
+            }
+        }
+        //配置推送、sleepNativeMethod的放行请求和natives导出请求都走这个回调
+        registerConfigCallback(loadMikRomConfig_method,getDexFileMethod(DexFileClazz,"releaseDebugGate"),
+                getDexFileMethod(DexFileClazz,"dumpNativeRegistry"),item);
+        if(item.isJNIMethodPrint && item.jniTraceMode==1){
+            startJniProfileDumpWatcher(DexFileClazz,item.packageName);
+        }
+    }
+
+    //MikRomService监听到mik.conf或break.conf修改后推送过来,不用重启app。
+    //sleepNativeMethod等待调试器时的放行请求和natives导出请求也由MikRomService推送过来,不用轮询
+    public static void registerConfigCallback(final Method loadMethod,final Method releaseMethod,
+                                              final Method dumpNativesMethod,final PackageItem item){
+        IMikRom mikrom=getiMikRom();
+        if(mikrom==null){
+            return;
+        }
+        IMikRomCallback callback=new IMikRomCallback.Stub() {
+            @Override
+            public void onConfigChanged(byte[] diff) {
+                if(loadMethod==null){
+                    return;
+                }
+                try {
+                    Log.e("mikrom", "onConfigChanged size:"+diff.length);
+                    loadMethod.invoke(null,diff);
+                } catch (Exception e) {
+                    Log.e("mikrom", "onConfigChanged err:"+e.getMessage());
+                }
+                applyConfig(item,ConfigSnapshot.parse(diff));
+            }
+
+            @Override
+            public void onDebugRelease() {
+                if(releaseMethod==null){
+                    Log.e("mikrom", "onDebugRelease releaseDebugGate_method is null");
+                    return;
+                }
+                try {
+                    Log.e("mikrom", "releaseDebugGate "+item.packageName);
+                    releaseMethod.invoke(null);
+                } catch (Exception e) {
+                    Log.e("mikrom", "onDebugRelease err:"+e.getMessage());
+                }
+            }
+
+            @Override
+            public void onDumpNativeRegistry() {
+                if(dumpNativesMethod==null){
+                    Log.e("mikrom", "onDumpNativeRegistry dumpNativeRegistry_method is null");
+                    return;
+                }
+                try {
+                    Log.e("mikrom", "dumpNativeRegistry "+item.packageName+" "+dumpNativesMethod.invoke(null));
+                } catch (Exception e) {
+                    Log.e("mikrom", "onDumpNativeRegistry err:"+e.getMessage());
+                }
+            }
+
+            @Override
+            public void onBreakConfigChanged(String data) {
+                breakConfig=data;
+                List<String> classes=buildBreakClasses(item);
+                Log.e("mikrom", "onBreakConfigChanged count:"+classes.size());
+                bClass=classes;
+            }
+        };
+        try {
+            mikrom.registerConfigCallback(item.packageName,callback);
+        } catch (RemoteException e) {
+            Log.e("mikrom", "registerConfigCallback err:"+e.getMessage());
         }
     }
-    public static List<PackageItem> mikConfigs;
-    public static List<String> bClass=new ArrayList<String>();
-    public static List<String> whiteClass=new ArrayList<String>();
-    public static String whitePath="";
+
+    //把推送来的字段写回item,并重新生成脱壳用的白名单和断点类列表。
+    //gadget,dex,io重定向这些启动时加载的功能不会重新加载,改了要重启app
+    public static void applyConfig(PackageItem item,JSONObject changed){
+        if(changed==null){
+            return;
+        }
+        Iterator<String> keys=changed.keys();
+        while(keys.hasNext()){
+            String key=keys.next();
+            try {
+                Field field=PackageItem.class.getField(key);
+                Object value=changed.get(key);
+                if(field.getType()==boolean.class && value instanceof Boolean){
+                    field.setBoolean(item,(Boolean)value);
+                }else if(field.getType()==int.class && value instanceof Integer){
+                    field.setInt(item,(Integer)value);
+                }else if(field.getType()==String.class && value instanceof String){
+                    field.set(item,value);
+                }
+            } catch (Exception e) {
+                //PackageItem没有的字段只给art用
+            }
+        }
+        List<String> white=new ArrayList<String>();
+        if(item.isTuoke && item.whiteClass!=null && item.whiteClass.length()>0){
+            for(String cls : item.whiteClass.split("\n")){
+                white.add(cls);
+            }
+        }
+        whiteClass=white;
+        whitePath=item.isTuoke && item.whitePath!=null?item.whitePath:"";
+        bClass=buildBreakClasses(item);
+        Log.e("mikrom", "applyConfig "+changed.names()+" whiteClass:"+whiteClass.size()+" breakClass:"+bClass.size());
+    }
+
+    //break.conf加上当前包的breakClass
+    public static List<String> buildBreakClasses(PackageItem item){
+        List<String> classes=new ArrayList<String>();
+        for(String cls : breakConfig.split("\n")){
+            classes.add(cls);
+        }
+        if(item.isTuoke && item.breakClass!=null && item.breakClass.length()>0){
+            for(String cls : item.breakClass.split("\n")){
+                classes.add(cls);
+            }
+        }
+        return classes;
+    }
+
+
+    //jni统计模式下,轮询MikRomService是否有导出请求,有则立即把统计结果写入trace文件
+    public static void startJniProfileDumpWatcher(Class DexFileClazz,final String packageName){
+        Method dumpJniProfile_method = null;
+        for (Method field : DexFileClazz.getDeclaredMethods()) {
+            if (field.getName().equals("dumpJniProfile")) {
+                dumpJniProfile_method = field;
+                dumpJniProfile_method.setAccessible(true);
+            }
+        }
+        if(dumpJniProfile_method==null){
+            Log.e("mikrom", "startJniProfileDumpWatcher dumpJniProfile_method is null");
+            return;
+        }
+        final Method dumpMethod=dumpJniProfile_method;
+        Thread watcher=new Thread(new Runnable() {
+            @Override
+            public void run() {
+                while(true){
+                    try {
+                        Thread.sleep(1000);
+                        IMikRom mikrom=getiMikRom();
+                        if(mikrom!=null && mikrom.takeJniProfileDumpRequest(packageName)){
+                            Log.e("mikrom", "dumpJniProfile "+packageName);
+                            dumpMethod.invoke(null);
+                        }
+                    } catch (Exception e) {
+                        Log.e("mikrom", "startJniProfileDumpWatcher err:"+e.getMessage());
+                    }
+                }
+            }
+        });
+        watcher.setDaemon(true);
+        watcher.start();
+    }
+    public static List<PackageItem> mikConfigs=new ArrayList<PackageItem>();
+    //break.conf更新时整体替换
+    public static volatile List<String> bClass=new ArrayList<String>();
+    //配置推送时整体替换
+    public static volatile List<String> whiteClass=new ArrayList<String>();
+    public static volatile String whitePath="";
+    //上次读到的break.conf,配置推送改了breakClass时用来重新生成bClass
+    private static volatile String breakConfig="";
 
     public static String readConfig(String path){
         String res="";
@@ -510,20 +838,31 @@ public class Fartext {
         return iMikRom;
     }
 
-    public static String getMikConfig(){
+    //通过MikRomService拿到只读fd后直接读取,文件再大也不经过binder事务
+    public static String readServiceFile(String path){
         try {
             IMikRom mikrom=getiMikRom();
             if(mikrom==null){
                 return "";
             }
-            return mikrom.readFile("/data/system/mik.conf");
-        } catch (RemoteException e) {
-            e.printStackTrace();
+            ParcelFileDescriptor pfd=mikrom.openFile(path);
+            return pfd!=null?MikRomManager.readFully(pfd):"";
+        } catch (Exception e) {
+            Log.e("mikrom", "readServiceFile "+path+" err:"+e.getMessage());
         }
         return "";
     }
 
-    public static void initConfig(){
+    public static String getMikConfig(){
+        return readServiceFile("/data/system/mik.conf");
+    }
+
+    //非目标进程返回false,此时不读取配置,mikConfigs保持为空
+    public static boolean initConfig(){
+        String processName = ActivityThread.currentProcessName();
+        if(!TargetFilter.mayBeTarget(processName)){
+            return false;
+        }
         try {
             mikConfigs=new ArrayList<PackageItem>();
             String mikromConfigJson=getMikConfig();
@@ -549,10 +888,18 @@ public class Fartext {
 
                     cfg.isInvokePrint = jobj.getBoolean("isInvokePrint");
                     cfg.isJNIMethodPrint = jobj.getBoolean("isJNIMethodPrint");
+                    cfg.jniTraceMode = jobj.optInt("jniTraceMode",0);
+                    cfg.jniTraceLibs = jobj.optString("jniTraceLibs","");
+                    cfg.jniTraceMethods = jobj.optString("jniTraceMethods","");
+                    cfg.jniDataMaxBytes = jobj.optInt("jniDataMaxBytes",0);
+                    cfg.jniDataSampleRate = jobj.optInt("jniDataSampleRate",0);
                     cfg.isRegisterNativePrint = jobj.getBoolean("isRegisterNativePrint");
 
                     cfg.traceMethod = jobj.getString("traceMethod");
+                    cfg.traceMode = jobj.optInt("traceMode",0);
+                    cfg.traceSampleRate = jobj.optInt("traceSampleRate",0);
                     cfg.sleepNativeMethod=jobj.getString("sleepNativeMethod");
+                    cfg.debugWaitTimeout=jobj.optInt("debugWaitTimeout",0);
                     cfg.fridaJsPath=jobj.getString("fridaJsPath");
                     cfg.port=jobj.getInt("port");
                     cfg.gadgetPath=jobj.getString("gadgetPath");
@@ -567,11 +914,11 @@ public class Fartext {
                     cfg.isBlock=jobj.getBoolean("isBlock");
                     mikConfigs.add(cfg);
                     Log.e("mikrom", "initConfig packageName" + cfg.packageName);
-                    String processName = ActivityThread.currentProcessName();
                 }
             }
             String breakPath="/data/system/break.conf";
-            String breakData= getiMikRom().readFile(breakPath);
+            String breakData= readServiceFile(breakPath);
+            breakConfig=breakData;
             for(String item : breakData.split("\n")){
                 bClass.add(item);
             }
@@ -579,8 +926,8 @@ public class Fartext {
         }
         catch(Exception ex){
             Log.e("mikrom", "initConfig err:" + ex.getMessage());
-            return ;
         }
+        return true;
     }
 
     public static void mycopy(String srcFileName, String trcFileName) {
@@ -785,13 +1132,10 @@ public class Fartext {
                         }
                     }else{
                         boolean use14=false;
-                        IMikRom mikrom=getiMikRom();
-                        if(mikrom!=null){
-                            String res= mikrom.readFile("/data/system/fver14.conf");
-                            Log.e("mikrom", "fver14.conf data "+res);
-                            if(res.contains("1")){
-                                use14=true;
-                            }
+                        String res= readServiceFile("/data/system/fver14.conf");
+                        Log.e("mikrom", "fver14.conf data "+res);
+                        if(res.contains("1")){
+                            use14=true;
                         }
                         if (System.getProperty("os.arch").indexOf("64") >= 0) {
                             if(use14){
@@ -931,30 +1275,50 @@ public class Fartext {
         return null;
     }
 
-    public static String getClassList() {
+    //返回whitePath中的类名,Lcom/a/B;格式转成com.a.B,优先由native mmap整个文件读取
+    public static String[] getClassList() {
         String processName = ActivityThread.currentProcessName();
-        BufferedReader br = null;
         if(whitePath.length()<=0){
             Log.e("mikrom", "getClassList processName:"+processName+" not whitePath");
-            return "";
+            return new String[0];
         }
         Log.e("mikrom", "getClassList processName:"+processName+" whitePath:"+whitePath);
-        StringBuilder sb = new StringBuilder();
+        ParcelFileDescriptor pfd = null;
         try {
-            br = new BufferedReader(new FileReader(whitePath));
+            //优先通过MikRomService打开,app自身没有权限读取的路径也能用
+            IMikRom mikrom = getiMikRom();
+            if (mikrom != null) {
+                pfd = mikrom.openFile(whitePath);
+            }
+            if (pfd == null) {
+                pfd = ParcelFileDescriptor.open(new File(whitePath), ParcelFileDescriptor.MODE_READ_ONLY);
+            }
+            Method readClassList = getDexFileMethod(Class.forName("dalvik.system.DexFile"), "readClassListFile");
+            if (readClassList != null) {
+                String[] classes = (String[]) readClassList.invoke(null, pfd.getFd());
+                if (classes != null) {
+                    return classes;
+                }
+            }
+            List<String> classes = new ArrayList<String>();
+            BufferedReader br = new BufferedReader(new InputStreamReader(new FileInputStream(pfd.getFileDescriptor())));
             String line;
             while ((line = br.readLine()) != null) {
-
-                if (line.length() >= 2) {
-                    sb.append(line + "\n");
+                if (line.length() < 2) {
+                    continue;
+                }
+                if (line.startsWith("L") && line.endsWith(";")) {
+                    line = line.substring(1, line.length() - 1).replace("/", ".");
                 }
+                classes.add(line);
             }
-            br.close();
+            return classes.toArray(new String[0]);
         } catch (Exception ex) {
             Log.e("mikrom", "getClassList err:" + ex.getMessage());
-            return "";
+            return new String[0];
+        } finally {
+            IoUtils.closeQuietly(pfd);
         }
-        return sb.toString();
     }
 
     public static ClassLoader getClassLoaderByClassName(String clsname){
@@ -989,7 +1353,7 @@ public class Fartext {
         return null;
     }
 
-    public static void fartWithClassList (String classlist){
+    public static void fartWithClassList (String[] classes){
         Log.e("mikrom", "fartWithClassList");
         ClassLoader appClassloader = getClassloader();
         if (appClassloader == null) {
@@ -1016,21 +1380,18 @@ public class Fartext {
                 dumpRepair_method.setAccessible(true);
             }
         }
-        String[] classes = classlist.split("\n");
         String tmp= classes[0];
-        if (tmp.startsWith("L") && tmp.endsWith(";")) {
-            tmp = tmp.substring(1, tmp.length() - 1);
-            tmp = tmp.replace("/", ".");
-        }
         ClassLoader classLoader=getClassLoaderByClassName(tmp);
         if(classLoader!=null){
-            for (String clsname : classes) {
-                String line = clsname;
-                if (line.startsWith("L") && line.endsWith(";")) {
-                    line = line.substring(1, line.length() - 1);
-                    line = line.replace("/", ".");
+            int[] kept = filterClassNames(DexFileClazz, classes);
+            if (kept != null) {
+                for (int index : kept) {
+                    invokeClass(classLoader, classes[index], dumpMethodCode_method);
+                }
+            } else {
+                for (String clsname : classes) {
+                    loadClassAndInvoke(classLoader, clsname, dumpMethodCode_method);
                 }
-                loadClassAndInvoke(classLoader, line, dumpMethodCode_method);
             }
         }else{
             Log.e("mikrom", "not found classLoader by class:"+tmp);
@@ -1056,8 +1417,8 @@ public class Fartext {
             return;
         }
         if(item.isBlock){
-            String classlist = getClassList();
-            if (!classlist.equals("")) {
+            final String[] classlist = getClassList();
+            if (classlist.length > 0) {
                 fartWithClassList(classlist);
                 return;
             }
@@ -1065,8 +1426,8 @@ public class Fartext {
             fart();
             Log.e("mikrom", "fart run over");
         }else{
-            String classlist = getClassList();
-            if (!classlist.equals("")) {
+            final String[] classlist = getClassList();
+            if (classlist.length > 0) {
                 new Thread(new Runnable() {
                     @Override
                     public void run() {
@@ -8,8 +8,16 @@ public class PackageItem{
     public String breakClass;
 
     public String traceMethod;
+    //traceMethod的trace方式,0为smali指令trace,1为基本块覆盖率,2为采样,3为方法调用trace,4为字段读写trace
+    public int traceMode;
+    //采样模式下每执行多少条指令采样一次
+    public int traceSampleRate;
 
+    //内核的反调试伪装(TracerPid为0,停止和跟踪状态显示为睡眠,wchan隐藏)不再对所有进程生效,
+    //也不会按mik.conf自动开启,需要时用root手动执行 echo "+uid <app的uid>" > /proc/mikrom_mask
     public String sleepNativeMethod;
+    //sleepNativeMethod等待调试器的最长秒数,0为一直等待,调试器附加或MikRomService放行后立即继续
+    public int debugWaitTimeout;
 
     public String fridaJsPath;
 
@@ -22,6 +30,16 @@ public class PackageItem{
     public boolean isRegisterNativePrint;
 
     public boolean isJNIMethodPrint;
+    //isJNIMethodPrint的方式,0为逐条记录jni调用,1为按调用方/jni函数/目标方法统计次数和耗时
+    public int jniTraceMode;
+    //只记录这些so发起的jni调用,匹配so路径的子串,多个用逗号或换行分割,为空则不过滤
+    public String jniTraceLibs;
+    //只记录目标为这些方法或字段的jni调用,匹配方法签名的子串,多个用逗号或换行分割,为空则不过滤
+    public String jniTraceMethods;
+    //记录NewStringUTF,GetStringUTFChars,GetByteArrayElements,SetByteArrayRegion的数据,每次最多记录的字节数,0为不记录
+    public int jniDataMaxBytes;
+    //数据记录的采样间隔,每多少次调用记录一次,0和1为每次都记录
+    public int jniDataSampleRate;
 
     public String whiteClass;
 
@@ -0,0 +1,93 @@
+package cn.mik;
+// change mikrom
+import android.os.SystemProperties;
+
+import org.json.JSONArray;
+import org.json.JSONObject;
+
+//mik.conf中启用的包名编译成的布隆过滤器,由MikRomService写入系统属性sys.mikrom.targets。
+//系统属性区是zygote映射好的只读共享内存,app启动时查一次属性就能知道自己是否可能是目标,
+//不是目标就不用走binder读取和解析配置。误判只会退回原来的完整流程。
+//同样编码的sys.mikrom.tuoke只包含开启了isTuoke的包,dex2oat用它决定是否降为verify编译,
+//C++侧的实现在art/runtime/mikrom/compile_policy.cc,两边的哈希必须保持一致。
+public class TargetFilter {
+    public static final String PROPERTY = "sys.mikrom.targets";
+    public static final String PROPERTY_TUOKE = "sys.mikrom.tuoke";
+    //属性值最长91字符,88个十六进制字符即352位
+    private static final int BITS = 352;
+    private static final int HASHES = 3;
+
+    private static int hash2(String name){
+        //FNV-1a,与String.hashCode组合成双重哈希
+        int h = 0x811c9dc5;
+        for (int i = 0; i < name.length(); i++) {
+            h ^= name.charAt(i);
+            h *= 0x01000193;
+        }
+        return h | 1;
+    }
+
+    private static int bit(String name, int i){
+        return Math.floorMod(name.hashCode() + i * hash2(name), BITS);
+    }
+
+    //把配置json中enabled为true的包名编译成属性值
+    public static String compile(String configJson){
+        return compile(configJson, null);
+    }
+
+    //flag不为null时只收录该布尔字段也为true的包
+    public static String compile(String configJson, String flag){
+        byte[] bits = new byte[BITS / 8];
+        try {
+            if(configJson != null && configJson.length() > 5){
+                JSONArray arr = new JSONArray(configJson);
+                for (int i = 0; i < arr.length(); i++) {
+                    JSONObject jobj = arr.getJSONObject(i);
+                    if(!jobj.optBoolean("enabled", false)){
+                        continue;
+                    }
+                    if(flag != null && !jobj.optBoolean(flag, false)){
+                        continue;
+                    }
+                    String packageName = jobj.optString("packageName", "");
+                    for (int k = 0; k < HASHES; k++) {
+                        int b = bit(packageName, k);
+                        bits[b / 8] |= (byte) (1 << (b % 8));
+                    }
+                }
+            }
+        } catch (Exception e) {
+            //解析失败时返回空串,app按未知处理,走完整流程
+            return "";
+        }
+        StringBuilder sb = new StringBuilder(BITS / 4);
+        for (byte b : bits) {
+            sb.append(String.format("%02x", b & 0xff));
+        }
+        return sb.toString();
+    }
+
+    //属性未设置或格式不对时返回true,由调用方走完整流程
+    public static boolean mayBeTarget(String processName){
+        return mayContain(PROPERTY, processName);
+    }
+
+    public static boolean mayContain(String property, String processName){
+        String value = SystemProperties.get(property, "");
+        if(value.length() != BITS / 4 || processName == null){
+            return true;
+        }
+        for (int k = 0; k < HASHES; k++) {
+            int b = bit(processName, k);
+            int nibble = Character.digit(value.charAt((b / 8) * 2 + (b % 8 < 4 ? 1 : 0)), 16);
+            if(nibble < 0){
+                return true;
+            }
+            if((nibble & (1 << (b % 4))) == 0){
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -1,7 +1,15 @@
 package com.android.server;
 import android.app.IMikRom;
+import android.app.IMikRomCallback;
 import android.content.Context;
 import android.os.Build;
+import android.os.FileObserver;
+import android.os.ParcelFileDescriptor;
+import android.os.RemoteCallbackList;
+import android.os.RemoteException;
+import android.os.SELinux;
+import android.os.SystemProperties;
+import android.system.Os;
 import android.util.Log;
 import android.util.Slog;
 
@@ -17,17 +25,159 @@ import java.io.InputStream;
 import java.io.InputStreamReader;
 import java.io.OutputStream;
 import java.io.RandomAccessFile;
+import java.util.HashMap;
+import java.util.HashSet;
 
 import android.util.Base64;
+import cn.mik.ConfigSnapshot;
+import cn.mik.TargetFilter;
+import org.json.JSONArray;
+import org.json.JSONObject;
 // change mikrom
 
 public class MikRomService extends IMikRom.Stub {
     private Context mContext;
     private String TAG="MikRomService";
+    //等待导出jni统计结果的包名,由目标进程轮询取走
+    private final HashSet<String> mJniProfileDumpRequests=new HashSet<String>();
+    private static final String CONFIG_DIR="/data/system";
+    private static final String CONFIG_PATH="/data/system/mik.conf";
+    private static final String BREAK_CONFIG_PATH="/data/system/break.conf";
+    //已注册配置推送的目标进程,cookie为包名
+    private final RemoteCallbackList<IMikRomCallback> mConfigCallbacks=new RemoteCallbackList<IMikRomCallback>();
+    //上次推送时各包的配置,用来计算变化的字段
+    private final HashMap<String,JSONObject> mPushedConfigs=new HashMap<String,JSONObject>();
+    private FileObserver mConfigObserver;
+    //dex2oat安装时保存脱壳目标dex的目录,dex2oat以app的uid在下面建各包自己的目录
+    private static final String DEX_CAPTURE_DIR="/data/misc/mikrom";
+    private static final String DEX_CAPTURE_CONTEXT="u:object_r:mikrom_data_file:s0";
     public MikRomService(Context context){
         super();
         mContext = context;
         Slog.d(TAG,"Construct");
+        String config=readFileAll(CONFIG_PATH);
+        publishTargets(config);
+        mPushedConfigs.putAll(parseConfigs(config));
+        startConfigObserver();
+        prepareDexCaptureDir();
+    }
+
+    //dex2oat不能写sdcard,只能写mikrom_data_file标签的目录。restorecon之后标签会丢,每次启动都重新设置
+    private void prepareDexCaptureDir(){
+        try {
+            File dir=new File(DEX_CAPTURE_DIR);
+            if(!dir.exists()){
+                Os.mkdir(DEX_CAPTURE_DIR,01733);
+            }
+            //各app只能在下面建目录,不能列出或删除别的包的目录
+            Os.chmod(DEX_CAPTURE_DIR,01733);
+            if(!DEX_CAPTURE_CONTEXT.equals(SELinux.getFileContext(DEX_CAPTURE_DIR))){
+                SELinux.setFileContext(DEX_CAPTURE_DIR,DEX_CAPTURE_CONTEXT);
+            }
+        } catch (Exception e) {
+            Slog.e(TAG,"prepareDexCaptureDir err:"+e.getMessage());
+        }
+    }
+
+    //返回配置中已启用的包,key为包名
+    private static HashMap<String,JSONObject> parseConfigs(String config){
+        HashMap<String,JSONObject> configs=new HashMap<String,JSONObject>();
+        try {
+            if(config.length()<=5){
+                return configs;
+            }
+            JSONArray arr=new JSONArray(config);
+            for(int i=0;i<arr.length();i++){
+                JSONObject jobj=arr.getJSONObject(i);
+                if(jobj.optBoolean("enabled",false)){
+                    configs.put(jobj.optString("packageName",""),jobj);
+                }
+            }
+        } catch (Exception e) {
+            Slog.e(TAG,"parseConfigs err:"+e.getMessage());
+        }
+        return configs;
+    }
+
+    //inotify监听mik.conf和break.conf,不管是writeFile还是adb push修改的都会推送给已注册的进程
+    private void startConfigObserver(){
+        mConfigObserver=new FileObserver(new File(CONFIG_DIR),FileObserver.CLOSE_WRITE|FileObserver.MOVED_TO){
+            @Override
+            public void onEvent(int event,String path){
+                if(CONFIG_PATH.endsWith("/"+path)){
+                    onConfigChanged();
+                }else if(BREAK_CONFIG_PATH.endsWith("/"+path)){
+                    onBreakConfigChanged();
+                }
+            }
+        };
+        mConfigObserver.startWatching();
+    }
+
+    //只推送本包变化了的字段,进程内叠加到当前配置上。删掉的字段和被禁用的包推送默认值
+    private void onConfigChanged(){
+        String config=readFileAll(CONFIG_PATH);
+        publishTargets(config);
+        HashMap<String,JSONObject> configs=parseConfigs(config);
+        synchronized (mPushedConfigs){
+            int count=mConfigCallbacks.beginBroadcast();
+            for(int i=0;i<count;i++){
+                String packageName=(String)mConfigCallbacks.getBroadcastCookie(i);
+                JSONObject oldCfg=mPushedConfigs.get(packageName);
+                JSONObject newCfg=configs.get(packageName);
+                if(oldCfg==null && newCfg==null){
+                    continue;
+                }
+                JSONObject changed=ConfigSnapshot.diff(oldCfg,newCfg);
+                if(changed.length()==0){
+                    continue;
+                }
+                try {
+                    mConfigCallbacks.getBroadcastItem(i).onConfigChanged(ConfigSnapshot.compile(changed));
+                    Slog.d(TAG,"push config "+packageName+" "+changed.names());
+                } catch (RemoteException e) {
+                    Slog.e(TAG,"push config "+packageName+" err:"+e.getMessage());
+                }
+            }
+            mConfigCallbacks.finishBroadcast();
+            mPushedConfigs.clear();
+            mPushedConfigs.putAll(configs);
+        }
+    }
+
+    private void onBreakConfigChanged(){
+        String data=readFileAll(BREAK_CONFIG_PATH);
+        synchronized (mPushedConfigs){
+            int count=mConfigCallbacks.beginBroadcast();
+            for(int i=0;i<count;i++){
+                try {
+                    mConfigCallbacks.getBroadcastItem(i).onBreakConfigChanged(data);
+                } catch (RemoteException e) {
+                    Slog.e(TAG,"push break config err:"+e.getMessage());
+                }
+            }
+            mConfigCallbacks.finishBroadcast();
+        }
+    }
+
+    @Override
+    public void registerConfigCallback(String packageName,IMikRomCallback callback){
+        Slog.d(TAG,"registerConfigCallback "+packageName);
+        mConfigCallbacks.register(callback,packageName);
+    }
+
+    //配置变化时重新生成目标包名的布隆过滤器,app启动时据此跳过非目标进程的配置读取
+    private void publishTargets(String config){
+        String targets=TargetFilter.compile(config);
+        //dex2oat按这个属性把脱壳目标降为verify编译,其它应用保持原来的编译过滤器
+        String tuoke=TargetFilter.compile(config,"isTuoke");
+        try {
+            SystemProperties.set(TargetFilter.PROPERTY,targets);
+            SystemProperties.set(TargetFilter.PROPERTY_TUOKE,tuoke);
+            Slog.d(TAG,"publishTargets "+targets+" tuoke "+tuoke);
+        } catch (Exception e) {
+            Slog.e(TAG,"publishTargets err:"+e.getMessage());
+        }
     }
 
     @Override
@@ -154,5 +304,119 @@ public class MikRomService extends IMikRom.Stub {
         writeTxtToFile(data,path);
     }
 
+    //以只读fd返回文件,调用方直接读取,数据不经过binder缓冲区
+    @Override
+    public ParcelFileDescriptor openFile(String path){
+        try {
+            File file=new File(path);
+            if(!file.isFile()){
+                return null;
+            }
+            return ParcelFileDescriptor.open(file,ParcelFileDescriptor.MODE_READ_ONLY);
+        } catch (Exception e) {
+            Slog.e(TAG,"openFile "+path+" err:"+e.getMessage());
+        }
+        return null;
+    }
+
+    //读完调用方传来的fd(一般是管道读端)后整体替换文件,返回时文件已写好
+    @Override
+    public void writeFileFd(String path,ParcelFileDescriptor data){
+        File file=new File(path);
+        File tmp=new File(path+".tmp");
+        makeRootDirectory(file.getParent());
+        try (InputStream in=new ParcelFileDescriptor.AutoCloseInputStream(data);
+             FileOutputStream out=new FileOutputStream(tmp)) {
+            byte[] buf=new byte[64*1024];
+            int n;
+            while((n=in.read(buf))!=-1){
+                out.write(buf,0,n);
+            }
+            out.getFD().sync();
+        } catch (IOException e) {
+            Slog.e(TAG,"writeFileFd "+path+" err:"+e.getMessage());
+            tmp.delete();
+            return;
+        }
+        if(!tmp.renameTo(file)){
+            Slog.e(TAG,"writeFileFd rename "+path+" failed");
+            tmp.delete();
+        }
+    }
+
+    @Override
+    public void requestJniProfileDump(String packageName){
+        Slog.d(TAG,"requestJniProfileDump "+packageName);
+        synchronized (mJniProfileDumpRequests){
+            mJniProfileDumpRequests.add(packageName);
+        }
+    }
+
+    @Override
+    public boolean takeJniProfileDumpRequest(String packageName){
+        synchronized (mJniProfileDumpRequests){
+            return mJniProfileDumpRequests.remove(packageName);
+        }
+    }
+
+    //返回包名对应配置的二进制快照,未配置或未启用时返回null
+    @Override
+    public byte[] getPackageConfig(String packageName){
+        try {
+            String config=readFileAll(CONFIG_PATH);
+            if(config.length()<=5){
+                return null;
+            }
+            JSONArray arr=new JSONArray(config);
+            for(int i=0;i<arr.length();i++){
+                JSONObject jobj=arr.getJSONObject(i);
+                if(jobj.optBoolean("enabled",false) && packageName.equals(jobj.optString("packageName",""))){
+                    return ConfigSnapshot.compile(jobj);
+                }
+            }
+        } catch (Exception e) {
+            Slog.e(TAG,"getPackageConfig err:"+e.getMessage());
+        }
+        return null;
+    }
+
+    @Override
+    public void requestDebugRelease(String packageName){
+        Slog.d(TAG,"requestDebugRelease "+packageName);
+        synchronized (mPushedConfigs){
+            int count=mConfigCallbacks.beginBroadcast();
+            for(int i=0;i<count;i++){
+                if(!packageName.equals(mConfigCallbacks.getBroadcastCookie(i))){
+                    continue;
+                }
+                try {
+                    mConfigCallbacks.getBroadcastItem(i).onDebugRelease();
+                } catch (RemoteException e) {
+                    Slog.e(TAG,"requestDebugRelease "+packageName+" err:"+e.getMessage());
+                }
+            }
+            mConfigCallbacks.finishBroadcast();
+        }
+    }
+
+    @Override
+    public void requestNativeRegistryDump(String packageName){
+        Slog.d(TAG,"requestNativeRegistryDump "+packageName);
+        synchronized (mPushedConfigs){
+            int count=mConfigCallbacks.beginBroadcast();
+            for(int i=0;i<count;i++){
+                if(!packageName.equals(mConfigCallbacks.getBroadcastCookie(i))){
+                    continue;
+                }
+                try {
+                    mConfigCallbacks.getBroadcastItem(i).onDumpNativeRegistry();
+                } catch (RemoteException e) {
+                    Slog.e(TAG,"requestNativeRegistryDump "+packageName+" err:"+e.getMessage());
+                }
+            }
+            mConfigCallbacks.finishBroadcast();
+        }
+    }
+
 
 }
@@ -436,7 +436,19 @@ public final class DexFile {
     //add
     private static native void fartextMethodCode(Object m);
     private static native boolean setMikRomConfig(Object configJson);
+    private static native boolean loadMikRomConfig(byte[] config);
     private static native void dumpRepair();
+    private static native void dumpJniProfile();
+    private static native void releaseDebugGate();
+    private static native boolean dumpNativeRegistry();
+    private static native long compileClassMatcher(String[] patterns);
+    private static native void releaseClassMatcher(long matcher);
+    private static native int[] filterClassNames(long white, long black, String[] names);
+    private static native String[] readClassListFile(int fd);
+    private static native int getClassDefCount(Object cookie);
+    private static native long indexClassDefs(Object cookie);
+    private static native void releaseClassDefIndex(long index);
+    private static native String[] getFilteredClassNames(Object cookie, long white, long black, long classDefs, int start, int count);
     //add end
 
     private static native boolean isBackedByOatFile(Object cookie);
@@ -87,6 +87,9 @@
 #include <asm/processor.h>
 #include "internal.h"
 
+/* mikrom anti-debug masking set, kept in base.c. */
+bool proc_mikrom_masked(struct task_struct *task);
+
 static inline void task_name(struct seq_file *m, struct task_struct *p)
 {
 	int i;
@@ -136,18 +139,21 @@ static const char * const task_state_array[] = {
 	"R (running)",		/*   0 */
 	"S (sleeping)",		/*   1 */
 	"D (disk sleep)",	/*   2 */
-	"S (sleeping)",		/*   4 */
-	"S (sleeping)",		/*   8 */
+	"T (stopped)",		/*   4 */
+	"t (tracing stop)",	/*   8 */
 	"X (dead)",		/*  16 */
 	"Z (zombie)",		/*  32 */
 };
 
-static inline const char *get_task_state(struct task_struct *tsk)
+static inline const char *get_task_state(struct task_struct *tsk, bool masked)
 {
 	unsigned int state = (tsk->state | tsk->exit_state) & TASK_REPORT;
 
 	BUILD_BUG_ON(1 + ilog2(TASK_REPORT) != ARRAY_SIZE(task_state_array)-1);
 
+	/* Masked tasks show stopped and tracing stop as sleeping. */
+	if (masked && (state & (__TASK_STOPPED | __TASK_TRACED)))
+		state = TASK_INTERRUPTIBLE;
 	return task_state_array[fls(state)];
 }
 
@@ -161,6 +167,7 @@ static inline void task_state(struct seq_file *m, struct pid_namespace *ns,
 	const struct cred *cred;
 	pid_t ppid = 0, tpid = 0;
 	struct task_struct *leader = NULL;
+	bool masked = proc_mikrom_masked(p);
 
 	rcu_read_lock();
 	if (pid_alive(p)) {
@@ -170,7 +177,8 @@ static inline void task_state(struct seq_file *m, struct pid_namespace *ns,
 		ppid = task_tgid_nr_ns(rcu_dereference(p->real_parent), ns);
 		leader = p->group_leader;
 	}
-	tpid=0;
+	if (masked)
+		tpid = 0;
 	cred = get_task_cred(p);
 	seq_printf(m,
 		"State:\t%s\n"
@@ -181,7 +189,7 @@ static inline void task_state(struct seq_file *m, struct pid_namespace *ns,
 		"Uid:\t%d\t%d\t%d\t%d\n"
 		"Gid:\t%d\t%d\t%d\t%d\n"
 		"Ngid:\t%d\n",
-		get_task_state(p),
+		get_task_state(p, masked),
 		leader ? task_pid_nr_ns(leader, ns) : 0,
 		pid_nr_ns(pid, ns),
 		ppid, tpid,
@@ -393,7 +401,7 @@ static int do_task_stat(struct seq_file *m, struct pid_namespace *ns,
 	char tcomm[sizeof(task->comm)];
 	unsigned long flags;
 
-	state = *get_task_state(task);
+	state = *get_task_state(task, proc_mikrom_masked(task));
 	vsize = eip = esp = 0;
 	permitted = ptrace_may_access(task, PTRACE_MODE_READ_FSCREDS | PTRACE_MODE_NOAUDIT);
 	mm = get_task_mm(task);
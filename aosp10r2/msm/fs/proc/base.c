@@ -88,6 +88,7 @@
 #include <linux/slab.h>
 #include <linux/flex_array.h>
 #include <linux/posix-timers.h>
+#include <linux/hashtable.h>
 #ifdef CONFIG_HARDWALL
 #include <asm/hardwall.h>
 #endif
@@ -228,6 +229,164 @@ static int proc_pid_auxv(struct seq_file *m, struct pid_namespace *ns,
 }
 
 
+/*
+ * mikrom anti-debug masking. Tasks whose uid or tgid is in the set get
+ * TracerPid 0, stopped and traced states shown as sleeping, and trace related
+ * wchan symbols shown as SyS_epoll_wait. The set is edited through
+ * /proc/mikrom_mask, one command per write: "+uid N", "-uid N", "+pid N",
+ * "-pid N" or "clear". Reading it lists the entries. Readers do an RCU hash
+ * lookup, and nothing at all while the set is empty, so tasks outside the set
+ * see stock procfs. Nothing adds entries on its own, not even for the apps in
+ * mik.conf: root has to write them, e.g. echo "+uid 10123" > /proc/mikrom_mask.
+ */
+#define MIKROM_MASK_UID		0
+#define MIKROM_MASK_PID		1
+#define MIKROM_MASK_HASH_BITS	6
+
+struct mikrom_mask_entry {
+	struct hlist_node node;
+	struct rcu_head rcu;
+	u64 key;
+};
+
+static DEFINE_HASHTABLE(mikrom_mask_table, MIKROM_MASK_HASH_BITS);
+static DEFINE_MUTEX(mikrom_mask_lock);
+static atomic_t mikrom_mask_count = ATOMIC_INIT(0);
+
+static inline u64 mikrom_mask_key(u32 type, u32 id)
+{
+	return ((u64)type << 32) | id;
+}
+
+/* Caller holds rcu_read_lock() or mikrom_mask_lock. */
+static struct mikrom_mask_entry *mikrom_mask_find(u64 key)
+{
+	struct mikrom_mask_entry *entry;
+
+	hash_for_each_possible_rcu(mikrom_mask_table, entry, node, key)
+		if (entry->key == key)
+			return entry;
+	return NULL;
+}
+
+/* Used by task_state() and do_task_stat() in array.c. */
+bool proc_mikrom_masked(struct task_struct *task)
+{
+	bool masked;
+
+	if (!atomic_read(&mikrom_mask_count))
+		return false;
+	rcu_read_lock();
+	masked = mikrom_mask_find(mikrom_mask_key(MIKROM_MASK_PID, task_tgid_nr(task))) ||
+		 mikrom_mask_find(mikrom_mask_key(MIKROM_MASK_UID,
+					from_kuid(&init_user_ns, task_uid(task))));
+	rcu_read_unlock();
+	return masked;
+}
+
+static void mikrom_mask_clear(void)
+{
+	struct mikrom_mask_entry *entry;
+	struct hlist_node *tmp;
+	int bkt;
+
+	hash_for_each_safe(mikrom_mask_table, bkt, tmp, entry, node) {
+		hash_del_rcu(&entry->node);
+		kfree_rcu(entry, rcu);
+	}
+	atomic_set(&mikrom_mask_count, 0);
+}
+
+static int mikrom_mask_show(struct seq_file *m, void *v)
+{
+	struct mikrom_mask_entry *entry;
+	int bkt;
+
+	mutex_lock(&mikrom_mask_lock);
+	hash_for_each(mikrom_mask_table, bkt, entry, node)
+		seq_printf(m, "%s %u\n",
+			   (entry->key >> 32) == MIKROM_MASK_PID ? "pid" : "uid",
+			   (u32)entry->key);
+	mutex_unlock(&mikrom_mask_lock);
+	return 0;
+}
+
+static int mikrom_mask_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, mikrom_mask_show, NULL);
+}
+
+static ssize_t mikrom_mask_write(struct file *file, const char __user *buf,
+				 size_t count, loff_t *ppos)
+{
+	char kbuf[32];
+	char *cmd;
+	char type[4];
+	u32 id;
+	u64 key;
+	struct mikrom_mask_entry *entry;
+	int err = 0;
+
+	if (count >= sizeof(kbuf))
+		return -EINVAL;
+	if (copy_from_user(kbuf, buf, count))
+		return -EFAULT;
+	kbuf[count] = '\0';
+	cmd = strstrip(kbuf);
+
+	mutex_lock(&mikrom_mask_lock);
+	if (!strcmp(cmd, "clear")) {
+		mikrom_mask_clear();
+		goto out;
+	}
+	if ((cmd[0] != '+' && cmd[0] != '-') ||
+	    sscanf(cmd + 1, "%3s %u", type, &id) != 2) {
+		err = -EINVAL;
+		goto out;
+	}
+	if (!strcmp(type, "uid"))
+		key = mikrom_mask_key(MIKROM_MASK_UID, id);
+	else if (!strcmp(type, "pid"))
+		key = mikrom_mask_key(MIKROM_MASK_PID, id);
+	else {
+		err = -EINVAL;
+		goto out;
+	}
+	entry = mikrom_mask_find(key);
+	if (cmd[0] == '+' && !entry) {
+		entry = kmalloc(sizeof(*entry), GFP_KERNEL);
+		if (!entry) {
+			err = -ENOMEM;
+			goto out;
+		}
+		entry->key = key;
+		hash_add_rcu(mikrom_mask_table, &entry->node, key);
+		atomic_inc(&mikrom_mask_count);
+	} else if (cmd[0] == '-' && entry) {
+		hash_del_rcu(&entry->node);
+		kfree_rcu(entry, rcu);
+		atomic_dec(&mikrom_mask_count);
+	}
+out:
+	mutex_unlock(&mikrom_mask_lock);
+	return err ? err : count;
+}
+
+static const struct file_operations mikrom_mask_fops = {
+	.open		= mikrom_mask_open,
+	.read		= seq_read,
+	.write		= mikrom_mask_write,
+	.llseek		= seq_lseek,
+	.release	= single_release,
+};
+
+static int __init proc_mikrom_mask_init(void)
+{
+	proc_create("mikrom_mask", S_IRUSR | S_IWUSR, NULL, &mikrom_mask_fops);
+	return 0;
+}
+fs_initcall(proc_mikrom_mask_init);
+
 #ifdef CONFIG_KALLSYMS
 /*
  * Provides a wchan file via kallsyms in a proper one-value-per-file format.
@@ -248,7 +407,7 @@ static int proc_pid_wchan(struct seq_file *m, struct pid_namespace *ns,
 			return seq_printf(m, "%lu", wchan);
 	}
 	else{
-		if(strstr(symname,"trace")){        //这里是新增的，如果符号名称包含trace，就固定改成sys_epoll_wait
+		if(proc_mikrom_masked(task) && strstr(symname,"trace")){        //被屏蔽的进程符号名称包含trace时固定改成sys_epoll_wait
 		    return seq_printf(m,"%s","SyS_epoll_wait");
 		}
 		return seq_printf(m, "%s", symname);